@@ -0,0 +1,47 @@
+#include <MycilaESPConnect.h>
+
+// Time to the portal popup with and without the HTTPS rejection listener.
+// Build once with the default and once with -D HTTPS_REJECTION=0, join the "Captive Portal SSID" network from a laptop,
+// then run the test client of this folder against the portal:
+//   python3 popup_time.py --host 4.3.2.1 --count 20
+
+#ifndef HTTPS_REJECTION
+  #define HTTPS_REJECTION 20
+#endif
+
+AsyncWebServer server(80);
+Mycila::ESPConnect espConnect(server);
+uint32_t lastLog = 0;
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    continue;
+
+  espConnect.listen([](Mycila::ESPConnect::State previous, Mycila::ESPConnect::State state) {
+    Serial.printf("====> %s => %s\n", espConnect.getStateName(previous), espConnect.getStateName(state));
+  });
+
+  // 0: nothing listens on port 443
+  espConnect.setHTTPSRejection(HTTPS_REJECTION);
+  Serial.printf("====> HTTPS rejection: %" PRIu16 " connections per second\n", espConnect.getHTTPSRejection());
+
+  // the portal stays up for the measurement
+  espConnect.setAutoRestart(false);
+  espConnect.setBlocking(false);
+  espConnect.begin("arduino-1", "Captive Portal SSID");
+
+  Serial.println("====> setup() completed...");
+}
+
+void loop() {
+  espConnect.loop();
+
+#ifdef ESPCONNECT_METRICS
+  if (millis() - lastLog > 5000) {
+    const Mycila::ESPConnect::Metrics& metrics = espConnect.getMetrics();
+    Serial.printf("====> HTTPS rejected: %" PRIu32 ", throttled: %" PRIu32 "\n", metrics.httpsRejected, metrics.httpsThrottled);
+    lastLog = millis();
+  }
+#endif
+}
@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MIT
+#
+# Test client measuring the time to the captive portal popup, like a phone joining the portal:
+# it first tries HTTPS on the portal IP, then falls back to the HTTP connectivity check and stops
+# as soon as the answer is not the expected 204 (the portal is detected).
+#
+#   python3 popup_time.py [--host 4.3.2.1] [--count 20] [--https-timeout 5]
+#
+# The HTTPS attempt ends with:
+#   refused   the SYN is answered by a reset: nothing listens on the port
+#   reset     the connection is accepted, then reset: setHTTPSRejection()
+#   timeout   nothing answered within --https-timeout, like a dropped SYN
+# Run it against the HTTPSRejection example built with and without the listener and compare the medians.
+
+import argparse
+import socket
+import statistics
+import time
+
+
+def try_https(host, port, timeout):
+    start = time.monotonic()
+    sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    sock.settimeout(timeout)
+    try:
+        sock.connect((host, port))
+        # accepted: the TLS client hello is answered by a reset, or by nothing
+        sock.sendall(b"\x16\x03\x01\x00\x00")
+        outcome = "reset" if sock.recv(1) == b"" else "answered"
+    except ConnectionRefusedError:
+        outcome = "refused"
+    except (ConnectionResetError, BrokenPipeError):
+        outcome = "reset"
+    except socket.timeout:
+        outcome = "timeout"
+    finally:
+        sock.close()
+    return outcome, time.monotonic() - start
+
+
+def probe_http(host, port, timeout):
+    start = time.monotonic()
+    with socket.create_connection((host, port), timeout=timeout) as sock:
+        sock.sendall(b"GET /generate_204 HTTP/1.1\r\nHost: connectivitycheck.gstatic.com\r\nConnection: close\r\n\r\n")
+        status = sock.makefile("rb").readline().split()
+    code = int(status[1]) if len(status) > 1 else 0
+    return code, time.monotonic() - start
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--host", default="4.3.2.1")
+    parser.add_argument("--http-port", type=int, default=80)
+    parser.add_argument("--https-port", type=int, default=443)
+    parser.add_argument("--https-timeout", type=float, default=5)
+    parser.add_argument("--count", type=int, default=10)
+    args = parser.parse_args()
+
+    popups = []
+    outcomes = {}
+    for i in range(args.count):
+        outcome, https = try_https(args.host, args.https_port, args.https_timeout)
+        code, http = probe_http(args.host, args.http_port, args.https_timeout)
+        outcomes[outcome] = outcomes.get(outcome, 0) + 1
+        # 204: no portal detected
+        if code != 204:
+            popups.append(https + http)
+        print("#%d HTTPS %s in %.0f ms, HTTP %d in %.0f ms" % (i + 1, outcome, https * 1000, code, http * 1000))
+        time.sleep(0.2)
+
+    print("HTTPS: %s" % ", ".join("%s %d" % item for item in sorted(outcomes.items())))
+    if popups:
+        print("Time to popup: min %.0f ms, median %.0f ms, max %.0f ms (%d/%d)" %
+              (min(popups) * 1000, statistics.median(popups) * 1000, max(popups) * 1000, len(popups), args.count))
+    else:
+        print("Portal not detected")
+
+
+if __name__ == "__main__":
+    main()
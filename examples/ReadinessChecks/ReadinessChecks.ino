@@ -0,0 +1,51 @@
+#include <MycilaESPConnect.h>
+
+// Readiness checks against the local stand-in server of this folder:
+//   python3 server.py --port 8000
+// then compile with -D READINESS_URL=\"http://<computer IP>:8000/generate_204\"
+// and switch the server between its modes with curl http://localhost:8000/mode/<ok|redirect|slow|error>
+
+#ifndef READINESS_URL
+  #define READINESS_URL "http://192.168.1.10:8000/generate_204"
+#endif
+
+AsyncWebServer server(80);
+Mycila::ESPConnect espConnect(server);
+uint32_t lastLog = 0;
+const char* hostname = "arduino-1";
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    continue;
+
+  espConnect.listen([](Mycila::ESPConnect::State previous, Mycila::ESPConnect::State state) {
+    Serial.printf("====> %s => %s\n", espConnect.getStateName(previous), espConnect.getStateName(state));
+    if (state == Mycila::ESPConnect::State::NETWORK_READY) {
+      const Mycila::ESPConnect::Readiness& readiness = espConnect.getReadiness();
+      Serial.printf("====> Ready in %" PRIu32 " ms (gateway: %" PRIu32 " ms, DNS: %" PRIu32 " ms, HTTP: %" PRIu32 " ms)\n", readiness.total, readiness.latency[0], readiness.latency[1], readiness.latency[3]);
+    }
+  });
+
+  // the server is on the LAN: only the gateway, the DNS server and the stand-in server are checked
+  espConnect.setReadinessChecks(Mycila::ESPConnect::READY_GATEWAY | Mycila::ESPConnect::READY_DNS | Mycila::ESPConnect::READY_HTTP,
+                                "pool.ntp.org",
+                                READINESS_URL,
+                                2000);
+
+  espConnect.setAutoRestart(true);
+  espConnect.setBlocking(false);
+  espConnect.begin(hostname, "Captive Portal SSID");
+
+  Serial.println("====> setup() completed...");
+}
+
+void loop() {
+  espConnect.loop();
+
+  if (millis() - lastLog > 5000) {
+    const Mycila::ESPConnect::Readiness& readiness = espConnect.getReadiness();
+    Serial.printf("====> %s, passed: 0x%02" PRIx8 "\n", espConnect.getStateName(), readiness.passed);
+    lastLog = millis();
+  }
+}
@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MIT
+#
+# Local stand-in server for the READY_HTTP readiness check.
+#
+#   python3 server.py [--port 8000] [--mode ok]
+#
+# Every path except /mode/* answers according to the current mode:
+#   ok        204 No Content: the check passes
+#   redirect  302 to a login page, like the captive portal of an upstream network: the check fails
+#   slow      204 after 5 s, longer than the readiness timeout: the check fails
+#   error     503: the check fails
+# The mode is changed while the device is running with: curl http://localhost:8000/mode/<mode>
+# Stopping the server makes the connection fail, like a LAN without upstream.
+
+import argparse
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+MODES = ("ok", "redirect", "slow", "error")
+mode = "ok"
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.0"
+
+    def do_GET(self):
+        global mode
+        if self.path.startswith("/mode/"):
+            requested = self.path[len("/mode/"):]
+            if requested not in MODES:
+                self._reply(400, "unknown mode: %s\n" % requested)
+                return
+            mode = requested
+            self._reply(200, "mode: %s\n" % mode)
+            return
+
+        start = time.monotonic()
+        if mode == "ok":
+            self._reply(204)
+        elif mode == "redirect":
+            self._reply(302, headers={"Location": "http://login.example.com/"})
+        elif mode == "slow":
+            time.sleep(5)
+            self._reply(204)
+        else:
+            self._reply(503)
+        self.log_message("%s %s: %s in %.0f ms", self.command, self.path, mode, (time.monotonic() - start) * 1000)
+
+    def _reply(self, status, body="", headers=None):
+        data = body.encode()
+        self.send_response_only(status)
+        self.send_header("Content-Length", str(len(data)))
+        self.send_header("Connection", "close")
+        for name, value in (headers or {}).items():
+            self.send_header(name, value)
+        self.end_headers()
+        self.wfile.write(data)
+
+    def log_request(self, code="-", size="-"):
+        # logged once the reply is sent, with the mode and the delay
+        pass
+
+
+def main():
+    global mode
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--port", type=int, default=8000)
+    parser.add_argument("--mode", choices=MODES, default="ok")
+    args = parser.parse_args()
+    mode = args.mode
+    server = ThreadingHTTPServer(("", args.port), Handler)
+    print("Readiness stand-in server on port %d, mode: %s" % (args.port, mode))
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
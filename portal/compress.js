@@ -1,12 +1,41 @@
-import { gzipAsync } from '@gfx/zopfli';
+import zlib from 'zlib';
 import FS from 'fs'
 import path from 'path'
 
 const SAVE_PATH = '../src';
 
+// usage: node compress.js [--split] [--budget=<bytes>]
+// --split: serve the CSS and the JS as separate assets, cached by the browser
+// --budget: maximum gzipped size of the portal (default: 9.5 KB), the build fails above
+const SPLIT = process.argv.includes('--split');
+const BUDGET_ARG = process.argv.find(arg => arg.startsWith('--budget='));
+const BUDGET = BUDGET_ARG ? parseInt(BUDGET_ARG.substring(9)) : 9.5 * 1024;
+
 const BUNDLE_CSS = FS.readFileSync(path.resolve(path.resolve(), './public/build/bundle.css'));
 const BUNDLE_JS = FS.readFileSync(path.resolve(path.resolve(), './public/build/main.js'));
-const INDEX_HTML = 
+
+// the asset paths change with their content so they can be cached forever
+function assetPath(buffer, ext){
+  return `/espconnect/app.${crc32(buffer).toString(16).padStart(8, '0')}.${ext}`;
+}
+
+const CSS_PATH = assetPath(BUNDLE_CSS, 'css');
+const JS_PATH = assetPath(BUNDLE_JS, 'js');
+
+const INDEX_HTML = SPLIT ?
+`<!DOCTYPE html>
+<html lang="en">
+<head>
+	<meta charset='utf-8'>
+	<meta name='viewport' content='width=device-width,initial-scale=1'>
+	<link rel='stylesheet' href='${CSS_PATH}'>
+	<script defer src='${JS_PATH}'></script>
+</head>
+<body>
+<div id="app"></div>
+</body>
+</html>
+` :
 `<!DOCTYPE html>
 <html lang="en">
 <head>
@@ -19,12 +48,43 @@ const INDEX_HTML =
 <body>
 <div id="app"></div>
 <script>
+addEventListener('DOMContentLoaded', () => {
 ${BUNDLE_JS}
+});
 </script>
 </body>
 </html>
 `;
 
+function crc32(buffer){
+  let crc = 0xFFFFFFFF;
+  for (const byte of buffer) {
+    crc ^= byte;
+    for (let k = 0; k < 8; k++)
+      crc = (crc >>> 1) ^ (0xEDB88320 & -(crc & 1));
+  }
+  return (crc ^ 0xFFFFFFFF) >>> 0;
+}
+
+// The page is a gzip stream left open: the deflate data ends with a sync flush and no final block
+// so that ESPConnect can append the scan results and the gzip trailer when serving it.
+function gzipOpen(html){
+  const header = Buffer.from([0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 2, 3]);
+  const body = zlib.deflateRawSync(html, { level: 9, memLevel: 9, finishFlush: zlib.constants.Z_SYNC_FLUSH });
+  return Buffer.concat([header, body]);
+}
+
+function gzip(buffer){
+  return zlib.gzipSync(buffer, { level: 9, memLevel: 9 });
+}
+
+function array(name, buffer){
+  return `const uint8_t ${name}[] PROGMEM = { 
+${ addLineBreaks(buffer) }
+};
+`;
+}
+
 function chunkArray(myArray, chunk_size){
   var index = 0;
   var arrayLength = myArray.length;
@@ -52,7 +112,23 @@ function addLineBreaks(buffer){
 
 (async function(){
   try{
-    const GZIPPED_INDEX = await gzipAsync(INDEX_HTML, { numiterations: 15 });
+    const INDEX = Buffer.from(INDEX_HTML);
+    const GZIPPED_INDEX = gzipOpen(INDEX);
+    const GZIPPED_CSS = SPLIT ? gzip(BUNDLE_CSS) : Buffer.alloc(0);
+    const GZIPPED_JS = SPLIT ? gzip(BUNDLE_JS) : Buffer.alloc(0);
+    const TOTAL = GZIPPED_INDEX.length + GZIPPED_CSS.length + GZIPPED_JS.length;
+
+    if (TOTAL > BUDGET) {
+      console.error(`[COMPRESS.js] Portal is ${TOTAL} bytes gzipped: over the budget of ${BUDGET} bytes`);
+      process.exit(1);
+    }
+
+    const ASSETS = SPLIT ? `
+#define ESPCONNECT_HTML_SPLIT
+#define ESPCONNECT_CSS_PATH "${CSS_PATH}"
+#define ESPCONNECT_JS_PATH "${JS_PATH}"
+${ array('ESPCONNECT_CSS', GZIPPED_CSS) }
+${ array('ESPCONNECT_JS', GZIPPED_JS) }` : '';
 
     const FILE = 
 `
@@ -61,15 +137,15 @@ function addLineBreaks(buffer){
 #define _espconnect_webpage_h
 
 const uint32_t ESPCONNECT_HTML_SIZE = ${GZIPPED_INDEX.length};
-const uint8_t ESPCONNECT_HTML[] PROGMEM = { 
-${ addLineBreaks(GZIPPED_INDEX) }
-};
-
+const uint32_t ESPCONNECT_HTML_LENGTH = ${INDEX.length};
+const uint32_t ESPCONNECT_HTML_CRC32 = 0x${crc32(INDEX).toString(16).padStart(8, '0')};
+// gzip header + non-final deflate blocks: the last block and the gzip trailer are appended when served
+${ array('ESPCONNECT_HTML', GZIPPED_INDEX) }${ASSETS}
 #endif
 `;
 
     FS.writeFileSync(path.resolve(path.resolve(), SAVE_PATH+'/espconnect_webpage.h'), FILE);
-    console.log(`[COMPRESS.js] Compressed Bundle into webpage.h header file | Total Size: ${(GZIPPED_INDEX.length / 1024).toFixed(2) }KB`)
+    console.log(`[COMPRESS.js] Compressed Bundle into webpage.h header file | Total Size: ${(TOTAL / 1024).toFixed(2) }KB / ${(BUDGET / 1024).toFixed(2) }KB`)
   }catch(err){
     return console.error(err);
   }
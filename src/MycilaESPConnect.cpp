@@ -22,7 +22,12 @@ static const char* NetworkStateNames[] = {
   "PORTAL_STARTED",
   "PORTAL_COMPLETE",
   "PORTAL_TIMEOUT",
+  "NETWORK_READY",
 };
+static_assert(sizeof(NetworkStateNames) / sizeof(NetworkStateNames[0]) == Mycila::ESPConnect::STATE_COUNT, "NetworkStateNames must match Mycila::ESPConnect::State");
+#ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
+static_assert(static_cast<int>(Mycila::ESPConnect::State::PORTAL_TIMEOUT) + 1 == static_cast<int>(Mycila::ESPConnect::State::NETWORK_READY), "NETWORK_READY must follow the last state");
+#endif
 
 const char* Mycila::ESPConnect::getStateName() const {
   return NetworkStateNames[static_cast<int>(_state)];
@@ -32,7 +37,7 @@ const char* Mycila::ESPConnect::getStateName(Mycila::ESPConnect::State state) co
   return NetworkStateNames[static_cast<int>(state)];
 }
 
-Mycila::ESPConnect::Mode Mycila::ESPConnect::getMode() const {
+Mycila::ESPConnect::Mode Mycila::ESPConnect::_computeMode() const {
   switch (_state) {
     case Mycila::ESPConnect::State::AP_STARTED:
       return Mycila::ESPConnect::Mode::AP;
@@ -41,9 +46,13 @@ Mycila::ESPConnect::Mode Mycila::ESPConnect::getMode() const {
       return Mycila::ESPConnect::Mode::AP;
 #endif
     case Mycila::ESPConnect::State::NETWORK_CONNECTED:
+    case Mycila::ESPConnect::State::NETWORK_READY:
     case Mycila::ESPConnect::State::NETWORK_DISCONNECTED:
     case Mycila::ESPConnect::State::NETWORK_RECONNECTING:
 #ifdef ESPCONNECT_ETH_SUPPORT
+      // both connected: the default interface chosen by the interface policy
+      if (ETH.hasIP() && WiFi.STA.hasIP())
+        return _primaryInterface == Mycila::ESPConnect::Mode::STA ? Mycila::ESPConnect::Mode::STA : Mycila::ESPConnect::Mode::ETH;
       if (ETH.hasIP())
         return Mycila::ESPConnect::Mode::ETH;
 #endif
@@ -59,6 +68,27 @@ Mycila::ESPConnect::Mode Mycila::ESPConnect::getMode() const {
   }
 }
 
+void Mycila::ESPConnect::_publishSnapshot() {
+  // computed outside of the critical section: this calls into the WiFi and ETH drivers
+  const Mycila::ESPConnect::Mode mode = _computeMode();
+  const uint32_t ip = static_cast<uint32_t>(getIPAddress(mode));
+
+#ifndef ESP8266
+  // serializes the writers (event task and loop task), and prevents an ISR on this core from spinning on an odd sequence
+  portENTER_CRITICAL(&_snapshotLock);
+#endif
+  const uint32_t seq = _snapshotSeq.load(std::memory_order_relaxed);
+  _snapshotSeq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  _snapshotState.store(static_cast<uint8_t>(_state), std::memory_order_relaxed);
+  _snapshotMode.store(static_cast<uint8_t>(mode), std::memory_order_relaxed);
+  _snapshotIP.store(ip, std::memory_order_relaxed);
+  _snapshotSeq.store(seq + 2, std::memory_order_release);
+#ifndef ESP8266
+  portEXIT_CRITICAL(&_snapshotLock);
+#endif
+}
+
 ESPCONNECT_STRING Mycila::ESPConnect::getMACAddress(Mycila::ESPConnect::Mode mode) const {
   ESPCONNECT_STRING mac;
 
@@ -245,6 +275,15 @@ void Mycila::ESPConnect::loadConfiguration(Mycila::ESPConnect::Config& config) {
   // dns
   if (preferences.isKey("dns"))
     config.ipConfig.dns.fromString(preferences.getString("dns"));
+  // eth ip
+  if (preferences.isKey("eth_ip"))
+    config.ethIPConfig.ip.fromString(preferences.getString("eth_ip"));
+  if (preferences.isKey("eth_subnet"))
+    config.ethIPConfig.subnet.fromString(preferences.getString("eth_subnet"));
+  if (preferences.isKey("eth_gateway"))
+    config.ethIPConfig.gateway.fromString(preferences.getString("eth_gateway"));
+  if (preferences.isKey("eth_dns"))
+    config.ethIPConfig.dns.fromString(preferences.getString("eth_dns"));
   // hostname
   if (preferences.isKey("hostname"))
     config.hostname = preferences.getString("hostname").c_str();
@@ -256,6 +295,7 @@ void Mycila::ESPConnect::loadConfiguration(Mycila::ESPConnect::Config& config) {
   LOGD(TAG, " - Subnet: %s", config.ipConfig.subnet.toString().c_str());
   LOGD(TAG, " - Gateway: %s", config.ipConfig.gateway.toString().c_str());
   LOGD(TAG, " - DNS: %s", config.ipConfig.dns.toString().c_str());
+  LOGD(TAG, " - ETH IP: %s", config.ethIPConfig.ip.toString().c_str());
   LOGD(TAG, " - Hostname: %s", config.hostname.c_str());
 }
 
@@ -268,6 +308,7 @@ void Mycila::ESPConnect::saveConfiguration(const Mycila::ESPConnect::Config& con
   LOGD(TAG, " - Subnet: %s", config.ipConfig.subnet.toString().c_str());
   LOGD(TAG, " - Gateway: %s", config.ipConfig.gateway.toString().c_str());
   LOGD(TAG, " - DNS: %s", config.ipConfig.dns.toString().c_str());
+  LOGD(TAG, " - ETH IP: %s", config.ethIPConfig.ip.toString().c_str());
   LOGD(TAG, " - Hostname: %s", config.hostname.c_str());
   Preferences preferences;
   preferences.begin("espconnect", false);
@@ -279,6 +320,10 @@ void Mycila::ESPConnect::saveConfiguration(const Mycila::ESPConnect::Config& con
   preferences.putString("subnet", config.ipConfig.subnet.toString().c_str());
   preferences.putString("gateway", config.ipConfig.gateway.toString().c_str());
   preferences.putString("dns", config.ipConfig.dns.toString().c_str());
+  preferences.putString("eth_ip", config.ethIPConfig.ip.toString().c_str());
+  preferences.putString("eth_subnet", config.ethIPConfig.subnet.toString().c_str());
+  preferences.putString("eth_gateway", config.ethIPConfig.gateway.toString().c_str());
+  preferences.putString("eth_dns", config.ethIPConfig.dns.toString().c_str());
   preferences.putString("hostname", config.hostname.c_str());
   preferences.end();
 }
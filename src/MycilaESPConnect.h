@@ -18,8 +18,12 @@
   #include <ESPAsyncWebServer.h>
 #endif
 
+#include "MycilaESPConnectImprov.h"
+
+#include <atomic>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #ifdef ESPCONNECT_NO_STD_STRING
   #include <WString.h>
@@ -42,6 +46,109 @@
   #define ESPCONNECT_PORTAL_TIMEOUT 180
 #endif
 
+#ifdef ESPCONNECT_ETH_SUPPORT
+  // Time in ms during which ETH_PHY_POWER is kept LOW with ESPCONNECT_ETH_RESET_ON_START
+  #ifndef ESPCONNECT_ETH_RESET_DELAY
+    #define ESPCONNECT_ETH_RESET_DELAY 350
+  #endif
+  // SPI clock in MHz of the SPI-based adapters (W5500, etc.)
+  #ifndef ESPCONNECT_ETH_SPI_FREQ_MHZ
+    #define ESPCONNECT_ETH_SPI_FREQ_MHZ 20
+  #endif
+#endif
+
+#ifndef ESP8266
+  // Address conflict detection (RFC 5227) before using a static IP: number of ARP probes, interval between them and wait after the last one in ms.
+  // Shorter than the RFC values (1 to 2 s between probes, 2 s wait) so that the fallback to DHCP is fast.
+  #ifndef ESPCONNECT_ARP_PROBE_NUM
+    #define ESPCONNECT_ARP_PROBE_NUM 3
+  #endif
+  #ifndef ESPCONNECT_ARP_PROBE_INTERVAL
+    #define ESPCONNECT_ARP_PROBE_INTERVAL 200
+  #endif
+  #ifndef ESPCONNECT_ARP_PROBE_WAIT
+    #define ESPCONNECT_ARP_PROBE_WAIT 400
+  #endif
+#endif
+
+#ifndef ESP8266
+  // Time in ms before failed readiness checks are run again
+  #ifndef ESPCONNECT_READINESS_RETRY
+    #define ESPCONNECT_READINESS_RETRY 5000
+  #endif
+  // Interval in ms between the pings of the gateway monitor once a reply is missing
+  #ifndef ESPCONNECT_GATEWAY_MONITOR_FAST_INTERVAL
+    #define ESPCONNECT_GATEWAY_MONITOR_FAST_INTERVAL 1000
+  #endif
+#endif
+
+#ifdef ESPCONNECT_DUTY_CYCLE
+  // Time in ms given to the connection with the state retained in RTC memory before falling back to the normal connection
+  #ifndef ESPCONNECT_DUTY_CYCLE_TIMEOUT
+    #define ESPCONNECT_DUTY_CYCLE_TIMEOUT 3000
+  #endif
+  // Remaining time in seconds of the retained DHCP lease under which it is not reused (DHCP is started again when half of it remains)
+  #ifndef ESPCONNECT_DUTY_CYCLE_LEASE_MARGIN
+    #define ESPCONNECT_DUTY_CYCLE_LEASE_MARGIN 300
+  #endif
+#endif
+
+#ifdef ESPCONNECT_TRACE
+  // Number of connection phases (spans) kept in the trace ring buffer
+  #ifndef ESPCONNECT_TRACE_SIZE
+    #define ESPCONNECT_TRACE_SIZE 32
+  #endif
+#endif
+
+// Maximum number of event subscribers
+#ifndef ESPCONNECT_MAX_SUBSCRIBERS
+  #define ESPCONNECT_MAX_SUBSCRIBERS 8
+#endif
+
+// Number of events that can be pending for dispatch to the subscribers
+#ifndef ESPCONNECT_EVENT_QUEUE_SIZE
+  #define ESPCONNECT_EVENT_QUEUE_SIZE 8
+#endif
+
+#ifdef ESPCONNECT_METRICS
+  // Number of distinct WiFi disconnect reasons counted (other reasons are counted with reason 0)
+  #ifndef ESPCONNECT_METRICS_REASONS
+    #define ESPCONNECT_METRICS_REASONS 16
+  #endif
+  // Size of the preallocated buffer used to render the OpenMetrics text
+  #ifndef ESPCONNECT_METRICS_BUFFER_SIZE
+    #define ESPCONNECT_METRICS_BUFFER_SIZE 4096
+  #endif
+  // Interval in seconds at which the WiFi RSSI is sampled into the histogram
+  #ifndef ESPCONNECT_METRICS_RSSI_INTERVAL
+    #define ESPCONNECT_METRICS_RSSI_INTERVAL 10
+  #endif
+#endif
+
+#ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
+  // Number of captive portal clients tracked by the admission control
+  #ifndef ESPCONNECT_ADMISSION_CLIENTS
+    #define ESPCONNECT_ADMISSION_CLIENTS 8
+  #endif
+#endif
+
+#ifdef ESPCONNECT_ADAPTIVE_TIMEOUT
+  // Number of time-to-IP samples required before the connection timeout is adapted
+  #ifndef ESPCONNECT_ADAPTIVE_TIMEOUT_MIN_SAMPLES
+    #define ESPCONNECT_ADAPTIVE_TIMEOUT_MIN_SAMPLES 5
+  #endif
+  // Number of samples after which the histogram is halved so that recent connections weigh more
+  #ifndef ESPCONNECT_ADAPTIVE_TIMEOUT_WINDOW
+    #define ESPCONNECT_ADAPTIVE_TIMEOUT_WINDOW 64
+  #endif
+  // Number of samples kept in RAM before the histogram is written to NVS, unless the learned time-to-IP changes first
+  #ifndef ESPCONNECT_ADAPTIVE_TIMEOUT_SAVE_EVERY
+    #define ESPCONNECT_ADAPTIVE_TIMEOUT_SAVE_EVERY 16
+  #endif
+  // Number of buckets of the time-to-IP histogram
+  #define ESPCONNECT_TIME_TO_IP_BUCKETS 16
+#endif
+
 namespace Mycila {
   class ESPConnect {
     public:
@@ -52,13 +159,16 @@ namespace Mycila {
         NETWORK_ENABLED,
 
         // NETWORK_ENABLED => NETWORK_CONNECTING
+        // NETWORK_CONNECTED => NETWORK_CONNECTING (applyConfig() with new WiFi credentials, without Ethernet IP)
+        // NETWORK_READY => NETWORK_CONNECTING (same)
         NETWORK_CONNECTING,
         // NETWORK_CONNECTING => NETWORK_TIMEOUT
         NETWORK_TIMEOUT,
         // NETWORK_CONNECTING => NETWORK_CONNECTED
         // NETWORK_RECONNECTING => NETWORK_CONNECTED
-        NETWORK_CONNECTED, // final state
+        NETWORK_CONNECTED, // final state without readiness checks
         // NETWORK_CONNECTED => NETWORK_DISCONNECTED
+        // NETWORK_READY => NETWORK_DISCONNECTED
         NETWORK_DISCONNECTED,
         // NETWORK_DISCONNECTED => NETWORK_RECONNECTING
         NETWORK_RECONNECTING,
@@ -79,6 +189,10 @@ namespace Mycila {
         // PORTAL_STARTED => PORTAL_TIMEOUT
         PORTAL_TIMEOUT, // final state
 #endif
+
+        // NETWORK_CONNECTED => NETWORK_READY (readiness checks passed)
+        // added after the other states so that their values and stateMask() bits do not change, with or without captive portal
+        NETWORK_READY = 13, // final state with readiness checks
       };
 
       enum class Mode {
@@ -91,10 +205,83 @@ namespace Mycila {
         ETH
       };
 
+      static constexpr size_t STATE_COUNT = static_cast<size_t>(State::NETWORK_READY) + 1;
+
+#ifdef ESPCONNECT_WATCHDOG
+      // Steps of the watchdog escalation ladder, in order
+      enum class Escalation {
+        // WiFi.reconnect()
+        RECONNECT = 0,
+        // WiFi radio stopped, then the network is started again from NETWORK_ENABLED
+        RADIO_RESTART,
+        // the stuck interface (Ethernet or WiFi) stopped and started again while the other one keeps running (ESPCONNECT_ETH_SUPPORT only, skipped otherwise)
+        INTERFACE_RESTART,
+        // ESP.restart()
+        SYSTEM_RESTART,
+      };
+      static constexpr size_t ESCALATION_COUNT = static_cast<size_t>(Escalation::SYSTEM_RESTART) + 1;
+#endif
+
+      // Bit mask of states used to filter the events received by a subscriber
+      static constexpr uint32_t stateMask(State state) { return 1UL << static_cast<uint32_t>(state); }
+      static constexpr uint32_t ALL_STATES = 0xFFFFFFFF;
+
+      // fields changed by applyConfig()
+      static constexpr uint8_t CONFIG_HOSTNAME = 1 << 0;
+      static constexpr uint8_t CONFIG_IP = 1 << 1;
+      static constexpr uint8_t CONFIG_WIFI = 1 << 2;
+      static constexpr uint8_t CONFIG_AP_MODE = 1 << 3;
+      static constexpr uint8_t CONFIG_DNS = 1 << 4;
+
+      // Event reasons above 1000 are not WiFi disconnect reasons
+      // NETWORK_CONNECTED with DHCP because the static IP is used by another host
+      static constexpr uint16_t REASON_IP_CONFLICT = 1000;
+      // NETWORK_DISCONNECTED because the gateway monitor did not get any reply from the gateway
+      static constexpr uint16_t REASON_GATEWAY_UNREACHABLE = 1001;
+
       typedef std::function<void(State previous, State state)> StateCallback;
 
+#ifndef ESP8266
+      // Readiness checks
+      // the default gateway answers ARP requests
+      static constexpr uint8_t READY_GATEWAY = 1 << 0;
+      // a configured name resolves
+      static constexpr uint8_t READY_DNS = 1 << 1;
+      // the system time is set (SNTP synced), required by TLS
+      static constexpr uint8_t READY_SNTP = 1 << 2;
+      // a configured http:// URL answers with a 2xx status
+      static constexpr uint8_t READY_HTTP = 1 << 3;
+      static constexpr size_t READY_CHECK_COUNT = 4;
+
+      typedef struct {
+          // READY_* checks passed during the last run
+          uint8_t passed;
+          // time in ms from the start of the run to the success of each check, by bit index of READY_*, 0 if not passed
+          uint32_t latency[READY_CHECK_COUNT];
+          // time in ms from NETWORK_CONNECTED to NETWORK_READY, 0 if not ready
+          uint32_t total;
+      } Readiness;
+
+      // ScanOptions::channels: the channels where networks were found by the previous scans and connections (all channels if none yet)
+      static constexpr uint16_t SCAN_HISTORY = 1 << 0;
+
+      typedef struct {
+          // probe requests for this SSID only (also finds a hidden network), empty for all networks
+          ESPCONNECT_STRING ssid;
+          // bit n for channel n (1 to 14), and SCAN_HISTORY, 0 for all the channels allowed in the country
+          uint16_t channels = 0;
+          // listen to beacons instead of sending probe requests
+          bool passive = false;
+          // active scan: an empty channel is left after minDwell ms, a channel with an AP after maxDwell ms (minDwell 0: always maxDwell)
+          uint16_t minDwell = 0;
+          uint16_t maxDwell = 500;
+          // connection: scan the channel of the last connection to the SSID first and join the first AP found
+          bool channelHint = false;
+      } ScanOptions;
+#endif
+
       typedef struct {
-          // Static IP address to use when connecting to WiFi (STA mode) or Ethernet
+          // Static IP address to use
           // If not set, DHCP will be used
           IPAddress ip;
           // Subnet mask: 255.255.255.0
@@ -114,10 +301,74 @@ namespace Mycila {
           ESPCONNECT_STRING wifiPassword;
           // whether we need to set the ESP to stay in AP mode or not, loaded from config, begin(), or from captive portal
           bool apMode;
-          // Static IP configuration to use (if any)
+          // Static IP configuration to use (if any) for WiFi (STA mode).
+          // With ESPCONNECT_ETH_SUPPORT and no ethIPConfig, it is used for Ethernet and WiFi uses DHCP.
           IPConfig ipConfig;
+          // Static IP configuration to use (if any) for Ethernet
+          IPConfig ethIPConfig;
       } Config;
 
+      typedef struct {
+          State previous;
+          State state;
+          // default interface at the time of the transition
+          Mode mode;
+          // IP address of the default interface at the time of the transition
+          IPAddress ip;
+          // WiFi disconnect reason code (wifi_err_reason_t) for NETWORK_DISCONNECTED,
+          // REASON_IP_CONFLICT for NETWORK_CONNECTED after an address conflict, 0 otherwise
+          uint16_t reason;
+      } Event;
+
+      typedef std::function<void(const Event& event)> EventCallback;
+
+      typedef std::function<void(bool online)> OnlineCallback;
+
+#ifdef ESPCONNECT_METRICS
+      typedef struct {
+          // WiFi disconnect reason code (wifi_err_reason_t), 0 for the reasons that did not fit
+          uint16_t reason;
+          uint32_t count;
+      } DisconnectCounter;
+
+      typedef struct {
+          // number of times the NETWORK_RECONNECTING state was entered
+          uint32_t reconnects;
+          // WiFi disconnections by reason
+          DisconnectCounter disconnects[ESPCONNECT_METRICS_REASONS];
+          // time spent in each state in ms, excluding the time spent in the current state
+          uint64_t stateTime[STATE_COUNT];
+          // millis() when the current state was entered
+          uint32_t stateSince;
+          // number of captive portal sessions (time spent is in stateTime[PORTAL_STARTED])
+          uint32_t portalSessions;
+          // number of WiFi scans and their total duration in ms
+          uint32_t scans;
+          uint64_t scanTime;
+          // captive portal WiFi credential tests
+          uint32_t credentialTestsPassed;
+          uint32_t credentialTestsFailed;
+          // RSSI samples per bucket: <= -90, <= -80, <= -70, <= -60, <= -50, > -50 dBm (not cumulative)
+          uint32_t rssiBuckets[6];
+          // number of times the default interface switched between ETH and WiFi while connected
+          uint32_t failovers;
+          // HTTPS connections rejected while the captive portal is active, and number of times the listener was paused by the rate limit
+          uint32_t httpsRejected;
+          uint32_t httpsThrottled;
+      } Metrics;
+#endif
+
+#ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
+      typedef struct {
+          // requests served
+          uint32_t admitted;
+          // requests rejected because the client exceeded its rate
+          uint32_t throttled;
+          // requests rejected because too many portal pages were being sent
+          uint32_t busy;
+      } AdmissionStats;
+#endif
+
     public:
 #ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
       explicit ESPConnect(AsyncWebServer& httpd) : _httpd(&httpd) {}
@@ -125,7 +376,14 @@ namespace Mycila {
 #else
       ESPConnect() {}
 #endif
-      ~ESPConnect() { end(); }
+      ~ESPConnect() {
+        end();
+#ifndef ESP8266
+        stopEventTask();
+        vSemaphoreDelete(_eventTaskStopped);
+        vSemaphoreDelete(_stateSignal);
+#endif
+      }
 
       // Start ESPConnect:
       //
@@ -135,7 +393,9 @@ namespace Mycila {
       // 4. If STA mode times out, or nothing configured, starts the captive portal
       //
       // Using this method will activate auto-load and auto-save of the configuration
-      void begin(const char* hostname, const char* apSSID, const char* apPassword = ""); // NOLINT
+      //
+      // Returns the state reached: in blocking mode, NETWORK_CONNECTED, AP_STARTED, or the current state if the blocking timeout expired
+      State begin(const char* hostname, const char* apSSID, const char* apPassword = ""); // NOLINT
 
       // Start ESPConnect:
       //
@@ -144,7 +404,9 @@ namespace Mycila {
       // 3. If STA mode fails, or empty WiFi credentials were passed, starts the captive portal
       //
       // Using this method will NOT auto-load or auto-save any configuration
-      void begin(const char* apSSID, const char* apPassword, Config config); // NOLINT
+      //
+      // Returns the state reached: in blocking mode, NETWORK_CONNECTED, AP_STARTED, or the current state if the blocking timeout expired
+      State begin(const char* apSSID, const char* apPassword, Config config); // NOLINT
 
       // loop() method to be called from main loop()
       void loop();
@@ -153,18 +415,123 @@ namespace Mycila {
       void end();
 
       // Listen for network state change
+      // The callback is called synchronously on each state change, from the task changing the state (WiFi event task or loop())
       void listen(StateCallback callback) { _callback = std::move(callback); }
 
+      // Subscribe to the network events matching the state mask (i.e. stateMask(State::NETWORK_CONNECTED) | stateMask(State::NETWORK_DISCONNECTED)).
+      // Subscribers are called from loop(), or from the event task if started, so they never block the WiFi event task.
+      // Sync subscribers are called directly from the task changing the state, like listen(): they must be short (i.e. wake up a task).
+      // Returns the subscription id to use with unsubscribe(), or 0 if ESPCONNECT_MAX_SUBSCRIBERS is reached.
+      uint16_t subscribe(EventCallback callback, uint32_t mask = ALL_STATES, bool sync = false);
+      // Remove a subscription
+      void unsubscribe(uint16_t id);
+
+      // Listen for the debounced online / offline state changes (see setDebounce()), called from loop()
+      void listenOnline(OnlineCallback callback) { _onlineCallback = std::move(callback); }
+
+      // Debounced connectivity: NETWORK_CONNECTED must persist for onlineHoldMs before going online,
+      // and any other state must persist for offlineHoldMs before going offline.
+      // 0 disables the hold-down (default), so the online state follows NETWORK_CONNECTED.
+      void setDebounce(uint32_t onlineHoldMs, uint32_t offlineHoldMs) {
+        _onlineHoldMs = onlineHoldMs;
+        _offlineHoldMs = offlineHoldMs;
+      }
+      uint32_t getOnlineHold() const { return _onlineHoldMs; }
+      uint32_t getOfflineHold() const { return _offlineHoldMs; }
+      // Returns the debounced connectivity state
+      bool isOnline() const { return _online; }
+      // Returns the number of link flaps absorbed by the debounce layer (connectivity lost and recovered, or the opposite, within the hold-down time)
+      uint32_t getFlapCount() const { return _flapCount; }
+
+#ifndef ESP8266
+      // Dispatch the events to the subscribers from a dedicated FreeRTOS task instead of loop()
+      bool startEventTask(uint32_t stackSize = 4096, UBaseType_t priority = 1, BaseType_t core = tskNO_AFFINITY);
+      // Stop the event task once the dispatch in progress completes, and wait for it (no wait when called from a subscriber):
+      // the events will be dispatched from loop() again
+      void stopEventTask();
+#endif
+
+      // State, mode and IPv4 address of the default interface, published together on each transition
+      typedef struct {
+          State state;
+          Mode mode;
+          // 0 when there is no IP address
+          uint32_t ip;
+      } Snapshot;
+
+      // Returns a consistent copy of the state, mode and IP address.
+      // Lock-free: can be called from any task or core, and from an ISR.
+      Snapshot getSnapshot() const {
+        Snapshot snapshot;
+        uint32_t seq;
+        do {
+          seq = _snapshotSeq.load(std::memory_order_acquire);
+          snapshot.state = static_cast<State>(_snapshotState.load(std::memory_order_relaxed));
+          snapshot.mode = static_cast<Mode>(_snapshotMode.load(std::memory_order_relaxed));
+          snapshot.ip = _snapshotIP.load(std::memory_order_relaxed);
+          std::atomic_thread_fence(std::memory_order_acquire);
+          // odd: a write is in progress
+        } while ((seq & 1) || seq != _snapshotSeq.load(std::memory_order_relaxed));
+        return snapshot;
+      }
+
       // Returns the current network state
-      State getState() const { return _state; }
+      State getState() const { return static_cast<State>(_snapshotState.load(std::memory_order_relaxed)); }
       // Returns the current network state name
       const char* getStateName() const;
       const char* getStateName(State state) const;
 
-      // returns the current default mode of the ESP (STA, AP, ETH). ETH has priority over STA if both are connected
-      Mode getMode() const;
+      // returns the current default mode of the ESP (STA, AP, ETH). When both ETH and STA are connected, see setInterfacePolicy()
+      Mode getMode() const { return static_cast<Mode>(_snapshotMode.load(std::memory_order_relaxed)); }
 
-      bool isConnected() const { return getIPAddress()[0] != 0; }
+      // Whether the default interface has an IP address
+      bool isConnected() const { return _snapshotIP.load(std::memory_order_relaxed) != 0; }
+
+#ifdef ESPCONNECT_ETH_SUPPORT
+      // ETH and WiFi are started together and NETWORK_CONNECTED is reached with the first interface getting an IP address.
+      // The preferred interface (ETH or STA) becomes the default one if it gets its IP address within gracePeriod ms after the first one.
+      // Afterwards, the default interface only changes when it loses its IP address.
+      // Default: ETH with no grace period, meaning that ETH always becomes the default interface when it is connected.
+      void setInterfacePolicy(Mode preferred, uint32_t gracePeriod = 0);
+      Mode getPreferredInterface() const { return _preferredInterface; }
+      uint32_t getInterfaceGracePeriod() const { return _interfaceGracePeriod; }
+      // Time in ms from the start of the interface (ETH or STA) to its first IP address, or 0 if not connected yet
+      uint32_t getTimeToIP(Mode mode) const;
+      // Negotiated Ethernet link speed in Mbps, or 0 if the link is down
+      uint16_t getEthernetLinkSpeed() const { return _ethLinkSpeed; }
+      // Whether the Ethernet link is full duplex, false if the link is down
+      bool isEthernetFullDuplex() const { return _ethFullDuplex; }
+      // Time in ms from ETH.begin() to the link up (PHY auto-negotiation), or 0 if the link is down
+      uint32_t getEthernetLinkUpTime() const { return _ethLinkUpTime; }
+#endif
+
+#ifndef ESP8266
+      // Readiness checks (READY_* mask) run concurrently once NETWORK_CONNECTED is reached, with a timeout in ms.
+      // NETWORK_READY is reached when they all pass, otherwise they are run again after ESPCONNECT_READINESS_RETRY ms.
+      // dnsName is resolved by READY_DNS and httpURL (http://host[:port]/path) is requested by READY_HTTP.
+      // 0 disables the readiness checks (default): NETWORK_CONNECTED is the final state.
+      void setReadinessChecks(uint8_t checks, const char* dnsName = nullptr, const char* httpURL = nullptr, uint32_t timeout = 2000);
+      // Result of the last run of the readiness checks
+      const Readiness& getReadiness() const { return _readiness; }
+
+      // Gateway liveness monitor of WiFi: the gateway is pinged every interval ms, then every ESPCONNECT_GATEWAY_MONITOR_FAST_INTERVAL ms once a reply is missing.
+      // Without any reply during window ms, WiFi is reconnected and NETWORK_DISCONNECTED has the reason REASON_GATEWAY_UNREACHABLE.
+      // 0 disables the monitor (default).
+      void setGatewayMonitor(uint32_t interval, uint32_t window);
+      // Round-trip time in ms of the last ping of the gateway, 0 if none
+      uint32_t getGatewayRTT() const { return _gatewayMonitor.rtt; }
+
+      // Options of the WiFi scans of the captive portal, and channel hint of the connection
+      void setScanOptions(ScanOptions options) { _scanOptions = std::move(options); }
+      const ScanOptions& getScanOptions() const { return _scanOptions; }
+      // Channels where networks were found by the previous scans and connections (bit n for channel n)
+      uint16_t getScanHistory() const { return _scanHistory; }
+      // Duration in ms of the last WiFi scan, 0 if none
+      uint32_t getScanDuration() const { return _scanDuration; }
+#endif
+
+      // Whether the static IP of the interface (STA or ETH) was found in use by another host: DHCP is used instead
+      bool hasIPConflict(Mode mode) const { return _ipConflicts & (1 << static_cast<int>(mode)); }
 
       ESPCONNECT_STRING getMACAddress() const { return getMACAddress(getMode()); }
       ESPCONNECT_STRING getMACAddress(Mode mode) const;
@@ -197,23 +564,126 @@ namespace Mycila {
       const Config& getConfig() const { return _config; }
       // Returns the current mutable configuration loaded or passed from begin() or from captive portal
       Config& getConfig() { return _config; }
-      // Set the current configuration
+      // Set the current configuration, used on the next connection attempt
       void setConfig(Config config) { _config = std::move(config); }
+      // Apply a new configuration to the running network with the minimal action:
+      // - hostname: set on the interfaces, announced with a DHCP renewal and mDNS
+      // - static IP, gateway, subnet: the interface is reconfigured without disconnecting
+      // - DNS only: the DNS server of the interface is replaced, the address is kept
+      // - SSID, password or BSSID: reassociation, without restarting the radio (NETWORK_CONNECTING unless Ethernet has an IP)
+      // - AP mode: the network is restarted
+      // The configuration is saved when it is managed by ESPConnect (begin() with a hostname).
+      // Returns the CONFIG_* flags of the fields which changed.
+      uint8_t applyConfig(Config config);
       // Maximum duration that the captive portal will be active before closing
       uint32_t getCaptivePortalTimeout() const { return _portalTimeout; }
       // Maximum duration that the captive portal will be active before closing
       void setCaptivePortalTimeout(uint32_t timeout) { _portalTimeout = timeout; }
 
+#ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
+      // Keep the captive portal up and retry the configured WiFi in the background:
+      // every interval seconds, try to connect for duration seconds (interval 0: disabled, default).
+      // When enabled, the captive portal does not time out.
+      void setBackgroundRetry(uint32_t interval, uint32_t duration = 10) {
+        _backgroundRetryInterval = interval;
+        _backgroundRetryDuration = duration;
+      }
+      uint32_t getBackgroundRetryInterval() const { return _backgroundRetryInterval; }
+      uint32_t getBackgroundRetryDuration() const { return _backgroundRetryDuration; }
+
+      // Lazy captive portal: only the softAP is started until a station associates.
+      // The DNS server, WiFi scan and web server are started on the first station and stopped when the last one leaves.
+      // The time without any station does not count toward the captive portal timeout.
+      bool isLazyCaptivePortal() const { return _lazyCaptivePortal; }
+      void setLazyCaptivePortal(bool lazy) { _lazyCaptivePortal = lazy; }
+
+      // Listen on port 443 of the softAP while the captive portal is active and reset the connections immediately,
+      // so that clients trying HTTPS fall back to HTTP without waiting (maxPerSecond 0: disabled, default)
+      void setHTTPSRejection(uint16_t maxPerSecond) { _httpsMaxPerSecond = maxPerSecond; }
+      uint16_t getHTTPSRejection() const { return _httpsMaxPerSecond; }
+
+      // Admission control of the captive portal requests (0: no limit, default):
+      // - maxConcurrent: maximum number of portal pages being sent at the same time
+      // - requestsPerSecond and burst: token bucket of each client IP address, starting empty for a new client
+      // Rejected requests get a 429 response.
+      void setPortalAdmission(uint8_t maxConcurrent, uint8_t requestsPerSecond, uint8_t burst);
+      const AdmissionStats& getAdmissionStats() const { return _admissionStats; }
+
+      // Improv-WiFi serial provisioning (nullptr: disabled, default).
+      // While the captive portal is started, the credentials received on the serial port, as Improv packets or as a WIFI: URI line,
+      // are tested and saved like the ones sent from the portal.
+      void setImprovSerial(Stream* serial, const char* firmware = "ESPConnect", const char* version = ESPCONNECT_VERSION);
+#endif
+
+      // Parse a WIFI:S:<ssid>;T:<WPA|WEP|nopass>;P:<password>;; URI (WiFi QR code) into the SSID and password of config
+      static bool parseWiFiURI(const char* uri, Config& config);
+
       // Maximum duration that the ESP will try to connect to the WiFi before giving up and start the captive portal
       uint32_t getConnectTimeout() const { return _connectTimeout; }
       // Maximum duration that the ESP will try to connect to the WiFi before giving up and start the captive portal
       void setConnectTimeout(uint32_t timeout) { _connectTimeout = timeout; }
 
+#ifdef ESPCONNECT_ADAPTIVE_TIMEOUT
+      // Connection timeout in seconds applied to the next connection attempt:
+      // the learned time-to-IP times the safety factor, clamped between the min and max, or getConnectTimeout() if not enough samples
+      uint32_t getEffectiveConnectTimeout() const;
+      // Learned time-to-IP in ms of the configured network at the configured percentile, or 0 if not enough samples
+      uint32_t getLearnedTimeToIP() const;
+      // Configure the adaptive connection timeout (defaults: 95th percentile, factor 3, between 5 and 60 seconds)
+      void setAdaptiveTimeout(uint8_t percentile, float factor, uint32_t minTimeout, uint32_t maxTimeout) {
+        _adaptivePercentile = percentile;
+        _adaptiveFactor = factor;
+        _adaptiveMinTimeout = minTimeout;
+        _adaptiveMaxTimeout = maxTimeout;
+      }
+      // Forget the learned time-to-IP of all networks
+      void clearTimeToIP();
+#else
+      // Connection timeout in seconds applied to the next connection attempt
+      uint32_t getEffectiveConnectTimeout() const { return _connectTimeout; }
+#endif
+
+#ifdef ESPCONNECT_WATCHDOG
+      // Maximum time in ms spent in a state before the watchdog takes the next step of the escalation ladder, 0 to disable (default).
+      // The ladder starts again from RECONNECT once NETWORK_CONNECTED or NETWORK_READY is reached.
+      void setWatchdog(State state, uint32_t dwellLimit) { _dwellLimits[static_cast<size_t>(state)] = dwellLimit; }
+      uint32_t getWatchdog(State state) const { return _dwellLimits[static_cast<size_t>(state)]; }
+      // Number of times the escalation was taken, persisted in NVS before a SYSTEM_RESTART
+      uint32_t getEscalations(Escalation escalation) const { return _escalations[static_cast<size_t>(escalation)]; }
+      // Next step of the escalation ladder, RECONNECT when the network is up
+      Escalation getEscalationLevel() const { return static_cast<Escalation>(_escalationLevel); }
+      static const char* getEscalationName(Escalation escalation);
+      // Forget the persisted escalation counters
+      void clearEscalations();
+      // Number of recoveries since boot: network up again after being lost, including across the restarts of the watchdog
+      uint32_t getRecoveries() const { return _recoveries; }
+      // Mean time to recovery in ms since boot, 0 without recovery
+      uint32_t getMTTR() const { return _recoveries ? static_cast<uint32_t>(_recoveryTime / _recoveries) : 0; }
+#endif
+
+#ifdef ESPCONNECT_DUTY_CYCLE
+      // Whether WiFi was connected after a deep sleep with the state retained in RTC memory (channel, BSSID and DHCP lease)
+      bool isFastWake() const { return _fastWake; }
+      // Time in ms during which the radio was on since the boot or the wake from deep sleep
+      uint32_t getRadioOnTime() const;
+      // Radio-on time in ms of the previous wake, 0 after a power-on
+      uint32_t getLastRadioOnTime() const;
+      // Stop ESPConnect and enter deep sleep for the given time in us (0: until another configured wakeup source)
+      void deepSleep(uint64_t us);
+      // Forget the state retained in RTC memory: the next wake uses the normal connection
+      static void clearRetainedState();
+#endif
+
       // Whether ESPConnect will block in the begin() method until the network is ready or not (old behaviour)
       bool isBlocking() const { return _blocking; }
       // Whether ESPConnect will block in the begin() method until the network is ready or not (old behaviour)
       void setBlocking(bool blocking) { _blocking = blocking; }
 
+      // Maximum duration in ms that begin() will block in blocking mode (0: no limit, default)
+      uint32_t getBlockingTimeout() const { return _blockingTimeout; }
+      // Maximum duration in ms that begin() will block in blocking mode (0: no limit, default)
+      void setBlockingTimeout(uint32_t timeout) { _blockingTimeout = timeout; }
+
       // Whether ESPConnect will restart the ESP if the captive portal times out or once it has completed (old behaviour)
       bool isAutoRestart() const { return _autoRestart; }
       // Whether ESPConnect will restart the ESP if the captive portal times out or once it has completed (old behaviour)
@@ -237,9 +707,79 @@ namespace Mycila {
       // when using auto-load and save of configuration, this method can clear saved states.
       void clearConfiguration();
 
+#ifdef ESPCONNECT_TRACE
+      // Export the recorded connection phases in Chrome trace-event JSON format.
+      // The output can be loaded in chrome://tracing or https://ui.perfetto.dev
+      void traceToJson(Print& out) const; // NOLINT
+      // Clear the recorded connection phases
+      void clearTrace();
+#endif
+
+#ifdef ESPCONNECT_METRICS
+      // Returns the connectivity counters
+      const Metrics& getMetrics() const { return _metrics; }
+      // Render the connectivity counters in OpenMetrics text format into the provided buffer.
+      // Returns the number of characters written (excluding the null terminator), 0 if the buffer is too small.
+      size_t metricsToOpenMetrics(char* buffer, size_t size) const;
+  #ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
+      // Serve the connectivity counters in OpenMetrics text format on the web server passed to the constructor
+      void enableMetricsEndpoint(const char* path = "/metrics");
+      void disableMetricsEndpoint();
+  #endif
+#endif
+
     private:
       State _state = State::NETWORK_DISABLED;
+      // seqlock protected copy of the state, mode and IP address for the readers
+      std::atomic<uint32_t> _snapshotSeq{0};
+      std::atomic<uint8_t> _snapshotState{static_cast<uint8_t>(State::NETWORK_DISABLED)};
+      std::atomic<uint8_t> _snapshotMode{static_cast<uint8_t>(Mode::NONE)};
+      std::atomic<uint32_t> _snapshotIP{0};
+#ifndef ESP8266
+      portMUX_TYPE _snapshotLock = portMUX_INITIALIZER_UNLOCKED;
+#endif
       StateCallback _callback = nullptr;
+
+      typedef struct {
+          uint16_t id;
+          uint32_t mask;
+          bool sync;
+          // the callback is being written by subscribe() or released by unsubscribe()
+          bool reserved;
+          // number of calls in progress: the slot is not reused until they return
+          uint8_t busy;
+          EventCallback callback;
+      } Subscriber;
+
+      Subscriber _subscribers[ESPCONNECT_MAX_SUBSCRIBERS] = {};
+      // debounce layer
+      OnlineCallback _onlineCallback = nullptr;
+      uint32_t _onlineHoldMs = 0;
+      uint32_t _offlineHoldMs = 0;
+      // debounced state
+      bool _online = false;
+      // raw state (NETWORK_CONNECTED) and millis() of its last change
+      bool _rawOnline = false;
+      uint32_t _rawOnlineSince = 0;
+      uint32_t _flapCount = 0;
+      uint16_t _lastSubscriberId = 0;
+      // pending events ring buffer
+      Event _events[ESPCONNECT_EVENT_QUEUE_SIZE];
+      size_t _eventsHead = 0;
+      size_t _eventsCount = 0;
+#ifndef ESP8266
+      portMUX_TYPE _eventsLock = portMUX_INITIALIZER_UNLOCKED;
+      // protects the subscriber slots, never held while a callback is called
+      portMUX_TYPE _subscribersLock = portMUX_INITIALIZER_UNLOCKED;
+      // cleared by the event task itself when it ends
+      TaskHandle_t _eventTask = nullptr;
+      volatile bool _eventTaskStopping = false;
+      // given by the event task when it ends
+      SemaphoreHandle_t _eventTaskStopped = xSemaphoreCreateBinary();
+      static void _eventTaskLoop(void* params);
+      // given on each state change to wake up a blocking begin()
+      SemaphoreHandle_t _stateSignal = xSemaphoreCreateBinary();
+#endif
       DNSServer* _dnsServer = nullptr;
       int64_t _lastTime = -1;
       ESPCONNECT_STRING _apSSID;
@@ -248,24 +788,169 @@ namespace Mycila {
       uint32_t _portalTimeout = ESPCONNECT_PORTAL_TIMEOUT;
       Config _config;
       bool _blocking = true;
+      uint32_t _blockingTimeout = 0;
       bool _autoRestart = true;
       bool _autoSave = false;
       uint32_t _restartRequestTime = 0;
       uint32_t _restartDelay = 1000;
+      // reason code of the last WiFi disconnection (wifi_err_reason_t)
+      uint16_t _lastDisconnectReason = 0;
+      // bit per Mode: static IP found in use by another host
+      uint8_t _ipConflicts = 0;
 #ifdef ESP8266
+      WiFiEventHandler onStationModeConnected;
       WiFiEventHandler onStationModeGotIP;
       WiFiEventHandler onStationModeDHCPTimeout;
       WiFiEventHandler onStationModeDisconnected;
+  #ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
+      WiFiEventHandler onSoftAPModeStationConnected;
+      WiFiEventHandler onSoftAPModeStationDisconnected;
+  #endif
 #else
       WiFiEventId_t _wifiEventListenerId = 0;
 #endif
 
       void _setState(State state);
-      void _onWiFiEvent(WiFiEvent_t event);
+      // NETWORK_CONNECTED or NETWORK_READY
+      bool _isNetworkUp() const { return _state == State::NETWORK_CONNECTED || _state == State::NETWORK_READY; }
+      Mode _computeMode() const;
+      void _publishSnapshot();
+      State _waitReady();
+      void _queueEvent(const Event& event);
+      void _debounce();
+      void _setOnline(bool online);
+      void _dispatchEvents();
+      void _notifySubscribers(const Event& event, bool sync);
+      void _onWiFiEvent(WiFiEvent_t event, uint16_t reason = 0);
       bool _durationPassed(uint32_t intervalSec, bool reset = true);
+#ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
+      bool _isBackgroundRetryIdle() const { return _state == State::PORTAL_STARTED && _backgroundRetryInterval && !_backgroundRetryStartedAt && !_credentialTestInProgress; }
+#else
+      bool _isBackgroundRetryIdle() const { return false; }
+#endif
       bool _connectionTimeout();
 
       void _startSTA();
+      void _reassociate();
+      // the next WiFi disconnection was requested by _reassociate(), which already called WiFi.begin()
+      bool _reassociating = false;
+
+      const IPConfig* _staticIPConfig(Mode mode) const;
+      void _setIPConfig(Mode mode, bool linkUp);
+      // set the DNS server of an interface with a static IP, without touching its address
+      void _setDNS(Mode mode);
+#ifndef ESP8266
+      typedef struct {
+          bool running;
+          // number of probes sent
+          uint8_t sent;
+          uint32_t lastAt;
+          // result of the check done in the TCP/IP thread: -1 pending, 0 free, 1 in use
+          volatile int8_t result;
+          uint32_t ip;
+          void* netif;
+      } ArpProbe;
+
+      ArpProbe _staProbe = {};
+  #ifdef ESPCONNECT_ETH_SUPPORT
+      ArpProbe _ethProbe = {};
+  #endif
+
+      void _startArpProbe(Mode mode);
+      void _stopArpProbe(Mode mode);
+      void _arpProbeLoop(Mode mode);
+
+      typedef struct {
+          // the name must stay valid until the lookup ends
+          const char* name;
+          // 0 failed, 1 resolved: valid when answered == generation, otherwise the lookup is pending
+          volatile int8_t result;
+          volatile uint32_t addr;
+          // incremented by each lookup: a late answer of a previous lookup is ignored
+          volatile uint32_t generation;
+          // generation of result and addr, written last by the TCP/IP thread
+          volatile uint32_t answered;
+      } DNSLookup;
+
+      typedef struct {
+          DNSLookup* lookup;
+          uint32_t generation;
+      } DNSQuery;
+
+      typedef struct {
+          // READY_* checks still running, 0 when no run is in progress
+          uint8_t pending;
+          uint32_t startedAt;
+          // end of the last run, 0 before the first run after NETWORK_CONNECTED
+          uint32_t finishedAt;
+          uint32_t connectedAt;
+          void* netif;
+          uint32_t gateway;
+          volatile int8_t gatewayFound;
+          uint32_t gatewayQueryAt;
+          DNSLookup dns;
+          DNSLookup httpHost;
+          int socket;
+          // 0: resolving, 1: connecting, 2: waiting for the status line
+          uint8_t httpStep;
+          char status[13];
+          uint8_t statusLength;
+      } ReadinessRun;
+
+      uint8_t _readinessChecks = 0;
+      uint32_t _readinessTimeout = 2000;
+      ESPCONNECT_STRING _readinessDNSName;
+      char _readinessHTTPHost[64] = {};
+      char _readinessHTTPPath[128] = {};
+      uint16_t _readinessHTTPPort = 80;
+      Readiness _readiness = {};
+      ReadinessRun _readinessRun = {};
+
+      void _readinessLoop();
+      void _startReadiness(uint32_t now);
+      void _stopReadiness();
+      void _readinessPassed(uint8_t check, uint32_t now);
+      void _readinessFailed(uint8_t check);
+      void _pollHTTP(uint32_t now);
+      static void _lookup(DNSLookup* lookup);
+      // -1 pending, 0 failed, 1 resolved
+      static int8_t _lookupResult(const DNSLookup& lookup) { return lookup.answered == lookup.generation ? lookup.result : -1; }
+
+      typedef struct {
+          // struct raw_pcb*, created and removed in the TCP/IP thread
+          void* pcb;
+          void* netif;
+          uint32_t gateway;
+          uint16_t seq;
+          uint32_t sentAt;
+          // written by the TCP/IP thread
+          volatile uint32_t replyAt;
+          volatile uint32_t rtt;
+          bool running;
+      } GatewayMonitor;
+
+      uint32_t _gatewayMonitorInterval = 0;
+      uint32_t _gatewayMonitorWindow = 0;
+      GatewayMonitor _gatewayMonitor = {};
+      // the next WiFi disconnection was requested by the gateway monitor
+      bool _gatewayLost = false;
+
+      void _gatewayMonitorLoop();
+      void _stopGatewayMonitor();
+
+      ScanOptions _scanOptions;
+      uint16_t _scanHistory = 0;
+      uint32_t _scanDuration = 0;
+      // millis() when the current scan started, 0 if no scan in progress
+      uint32_t _scanStartedAt = 0;
+      // millis() when a scan was started with esp_wifi_scan_start(), 0 otherwise
+      uint32_t _scanBitmapAt = 0;
+      // the results of the last scan were not added to the history yet
+      bool _scanPending = false;
+      // channel of the last connection to _channelHintSSID, 0 if none
+      uint8_t _channelHint = 0;
+      ESPCONNECT_STRING _channelHintSSID;
+#endif
 
       void _startAP();
       void _stopAP();
@@ -273,7 +958,125 @@ namespace Mycila {
       static int8_t _wifiSignalQuality(int32_t rssi);
 
 #ifdef ESPCONNECT_ETH_SUPPORT
+      Mode _preferredInterface = Mode::ETH;
+      uint32_t _interfaceGracePeriod = 0;
+      // default interface when both ETH and STA have an IP address
+      Mode _primaryInterface = Mode::NONE;
+      // time when the first interface got its IP address
+      uint32_t _firstIPAt = 0;
+      uint32_t _ethStartedAt = 0;
+      uint32_t _staStartedAt = 0;
+      uint32_t _ethTimeToIP = 0;
+      uint32_t _staTimeToIP = 0;
+      // ETH_PHY_POWER is LOW until _ethPhyResetAt + ESPCONNECT_ETH_RESET_DELAY
+      bool _ethPhyResetPending = false;
+      uint32_t _ethPhyResetAt = 0;
+      // time when ETH.begin() returned
+      uint32_t _ethBegunAt = 0;
+      uint16_t _ethLinkSpeed = 0;
+      bool _ethFullDuplex = false;
+      uint32_t _ethLinkUpTime = 0;
+
       void _startEthernet();
+      void _beginEthernet();
+      void _onEthernetLink(bool up);
+      void _onInterfaceUp(Mode mode);
+      void _onInterfaceDown(Mode mode);
+#endif
+
+#ifdef ESPCONNECT_TRACE
+      typedef struct {
+          // phase name (string literal)
+          const char* name;
+          // track (thread id in the trace viewer) on which the span is displayed
+          uint8_t track;
+          // start and end timestamps in microseconds, end is -1 while the span is still open
+          int64_t start;
+          int64_t end;
+      } TraceSpan;
+
+      TraceSpan _traceSpans[ESPCONNECT_TRACE_SIZE];
+      // index of the next slot to write in the ring buffer
+      size_t _traceHead = 0;
+      // number of valid spans in the ring buffer
+      size_t _traceCount = 0;
+  #ifndef ESP8266
+      mutable portMUX_TYPE _traceLock = portMUX_INITIALIZER_UNLOCKED;
+  #endif
+
+      void _traceBegin(const char* name, uint8_t track);
+      void _traceEnd(const char* name);
+#endif
+
+#ifdef ESPCONNECT_METRICS
+      Metrics _metrics = {};
+      uint32_t _rssiSampledAt = 0;
+  #ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
+      AsyncCallbackWebHandler* _metricsHandler = nullptr;
+      // whether _metricsBuffer is being sent
+      bool _metricsBusy = false;
+      char _metricsBuffer[ESPCONNECT_METRICS_BUFFER_SIZE];
+  #endif
+
+      void _countDisconnect(uint16_t reason);
+      void _sampleRSSI();
+#endif
+
+#ifdef ESPCONNECT_ADAPTIVE_TIMEOUT
+      // time-to-IP histogram of the configured network, persisted per SSID
+      uint16_t _timeToIP[ESPCONNECT_TIME_TO_IP_BUCKETS] = {};
+      // hash of the SSID the histogram belongs to, 0 if not loaded
+      uint32_t _timeToIPNetwork = 0;
+      // whether the last connection attempt timed out with the learned timeout
+      bool _adaptiveMiss = false;
+      uint8_t _adaptivePercentile = 95;
+      float _adaptiveFactor = 3;
+      uint32_t _adaptiveMinTimeout = 5;
+      uint32_t _adaptiveMaxTimeout = 60;
+      // time-to-IP set by the WiFi event task and recorded from loop(), or 0
+      volatile uint32_t _timeToIPSample = 0;
+      // samples recorded since the histogram was written to NVS
+      uint8_t _timeToIPUnsaved = 0;
+
+      void _loadTimeToIP();
+      void _saveTimeToIP();
+      // called from loop(): can write to NVS
+      void _recordTimeToIP(uint32_t ms);
+#endif
+
+#ifdef ESPCONNECT_WATCHDOG
+      uint32_t _dwellLimits[STATE_COUNT] = {};
+      // millis() of the last state change or escalation
+      uint32_t _watchdogSince = 0;
+      // index of the next Escalation
+      uint8_t _escalationLevel = 0;
+      uint32_t _escalations[ESCALATION_COUNT] = {};
+      // whether the network was lost and not up again yet, and since when
+      bool _outage = false;
+      uint32_t _outageSince = 0;
+      uint32_t _recoveries = 0;
+      uint64_t _recoveryTime = 0;
+
+      void _loadEscalations();
+      void _saveEscalations(uint32_t outage);
+      void _watchdogOnState(State previous, State state);
+      void _watchdogLoop();
+      void _escalate();
+#endif
+
+#ifdef ESPCONNECT_DUTY_CYCLE
+      // millis() when the radio was turned on, 0 if not yet
+      uint32_t _radioOnAt = 0;
+      // the connection in progress uses the retained state, and failed
+      bool _fastWakePending = false;
+      bool _fastWakeFailed = false;
+      bool _fastWake = false;
+      // the retained lease is used with a static configuration: the DHCP client is stopped until it expires
+      bool _leaseReused = false;
+
+      bool _startSTAFast();
+      void _retainState();
+      void _dutyCycleLoop();
 #endif
 
 #ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
@@ -282,10 +1085,61 @@ namespace Mycila {
       AsyncCallbackWebHandler* _scanHandler = nullptr;
       AsyncCallbackWebHandler* _connectHandler = nullptr;
       AsyncCallbackWebHandler* _homeHandler = nullptr;
+      // CSS and JS of the portal, when built with separate assets
+      AsyncCallbackWebHandler* _cssHandler = nullptr;
+      AsyncCallbackWebHandler* _jsHandler = nullptr;
       // WiFi connection test
       AsyncWebServerRequestPtr _pausedRequest;
       // timestamp of when the credential test started, or 0 if no test in progress
       uint32_t _credentialTestInProgress = 0;
+      // background retry of the configured WiFi while the portal is up
+      uint32_t _backgroundRetryInterval = 0;
+      uint32_t _backgroundRetryDuration = 10;
+      // timestamp of when the current attempt started, or 0 if no attempt in progress
+      uint32_t _backgroundRetryStartedAt = 0;
+      uint32_t _backgroundRetryEndedAt = 0;
+      // set from the WiFi events when the background retry got an IP address
+      bool _backgroundRetryConnected = false;
+      bool _lazyCaptivePortal = false;
+      // set from the WiFi events when a station associates or leaves the softAP
+      bool _portalStationsChanged = false;
+      // millis() since when the portal services are stopped in lazy mode, or 0
+      uint32_t _portalIdleSince = 0;
+      // HTTPS rejection
+      AsyncServer* _httpsServer = nullptr;
+      uint16_t _httpsMaxPerSecond = 0;
+      uint16_t _httpsWindowCount = 0;
+      uint32_t _httpsWindowStart = 0;
+      // millis() when the rate limit was exceeded, or 0
+      uint32_t _httpsPausedAt = 0;
+      bool _httpsListening = false;
+      // admission control
+      typedef struct {
+          uint32_t ip;
+          uint32_t lastSeen;
+          // in 1/1000 of token
+          uint32_t tokens;
+      } TokenBucket;
+      TokenBucket _admissionBuckets[ESPCONNECT_ADMISSION_CLIENTS] = {};
+      AdmissionStats _admissionStats = {};
+      uint8_t _admissionMaxConcurrent = 0;
+      uint8_t _admissionRate = 0;
+      uint8_t _admissionBurst = 1;
+      uint8_t _admissionInFlight = 0;
+      // Improv-WiFi serial provisioning
+      Stream* _improvSerial = nullptr;
+      std::unique_ptr<Improv::Device> _improv;
+      // credentials received from Improv, under test
+      Config* _improvUnderTest = nullptr;
+
+  #ifndef ESPCONNECT_NO_CP_API
+      AsyncCallbackWebHandler* _captivePortalAPIHandler = nullptr;
+    #ifndef ESP8266
+      // URI advertised with DHCP option 114
+      char _captivePortalAPI[48] = {0};
+    #endif
+      void _advertiseCaptivePortalAPI();
+  #endif
 
   #ifndef ESPCONNECT_NO_COMPAT_CP
       AsyncCallbackWebHandler* _connecttestHandler = nullptr;
@@ -300,9 +1154,35 @@ namespace Mycila {
   #endif
 
       void _startCaptivePortal();
-      void _stopCaptivePortal();
+      // disconnect: false to keep the WiFi connection (background retry succeeded)
+      void _stopCaptivePortal(bool disconnect = true);
+      void _backgroundRetry();
+      // DNS server, scan and web server of the captive portal
+      void _startPortalServices();
+      void _stopPortalServices();
+      void _updatePortalServices();
+      void _startHTTPSRejection();
+      void _stopHTTPSRejection();
+      void _throttleHTTPSRejection();
+      // heavy: the request sends the portal page, subject to the concurrency limit
+      bool _admit(AsyncWebServerRequest* request, bool heavy);
+      void _reject(AsyncWebServerRequest* request);
+      void _sendPortalPage(AsyncWebServerRequest* request);
+      void _buildPortalPageTail(std::vector<uint8_t>& tail, int count);
+      // portal page tail of the last scan results, reset when a new scan starts (std::atomic_load/store: also read from the async_tcp task)
+      std::shared_ptr<const std::vector<uint8_t>> _portalPageTail;
+      // credentials of the portal request or of Improv under test, or nullptr
+      Config* _credentialsUnderTest();
+      bool _isCredentialTestPending() const { return _pausedRequest.use_count() || _improvUnderTest != nullptr; }
+      void _improvLoop();
+      // returns false if the credentials cannot be tested now
+      bool _improvProvision(const char* ssid, const char* password);
+      void _sendPortalAsset(AsyncWebServerRequest* request, const char* contentType, const uint8_t* content, size_t len);
+      static void _scanResults(JsonArray json, int count);
       // scan WiFi networks
       void _scan();
+      // WiFi.scanComplete(), including the scans started with esp_wifi_scan_start()
+      int16_t _scanComplete();
       // test WiFi credentials
       void _startCredentialTest();
       void _processCredentialTest();
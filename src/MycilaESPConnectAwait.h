@@ -0,0 +1,350 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) Mathieu Carbou
+ */
+#pragma once
+
+// C++20 coroutine support for ESPConnect:
+//
+//   Mycila::Await::Executor executor;
+//
+//   Mycila::Await::Task app() {
+//     if (co_await Mycila::Await::connected(espConnect, 10000)) {
+//       ...
+//     }
+//   }
+//
+//   executor.spawn(app());
+//   executor.run(); // from a dedicated task, or call executor.runOnce() from loop()
+//
+// The executor and the awaitables only depend on the standard library so they can be used in a host test build
+// with any class providing the same State, Event, stateMask(), getState(), subscribe() and unsubscribe() as ESPConnect.
+
+#if __cplusplus >= 202002L && __has_include(<coroutine>)
+
+  #include <atomic>
+  #include <chrono>
+  #include <condition_variable>
+  #include <coroutine>
+  #include <deque>
+  #include <exception>
+  #include <functional>
+  #include <memory>
+  #include <mutex>
+  #include <utility>
+  #include <vector>
+
+  #if defined(ARDUINO) && !defined(ESP8266)
+    #include <WiFi.h>
+  #endif
+
+namespace Mycila {
+  namespace Await {
+    class Executor;
+
+    // Fire-and-forget coroutine started with Executor::spawn()
+    class Task {
+      public:
+        struct promise_type {
+            Executor* executor = nullptr;
+
+            Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+            // the coroutine is started by the executor
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            // the coroutine frame is destroyed when the coroutine completes
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+
+        Task(Task&& other) noexcept : _handle(std::exchange(other._handle, nullptr)) {}
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+        ~Task() {
+          // never spawned
+          if (_handle)
+            _handle.destroy();
+        }
+
+      private:
+        explicit Task(std::coroutine_handle<promise_type> handle) : _handle(handle) {}
+        std::coroutine_handle<promise_type> _handle;
+        friend class Executor;
+    };
+
+    // Single-threaded executor resuming the coroutines from the thread calling run() or runOnce().
+    // post() and schedule() are thread-safe and can be called from any task.
+    class Executor {
+      public:
+        typedef std::chrono::steady_clock Clock;
+
+        // Start a coroutine on this executor
+        void spawn(Task task) {
+          std::coroutine_handle<Task::promise_type> handle = std::exchange(task._handle, nullptr);
+          handle.promise().executor = this;
+          post(handle);
+        }
+
+        // Resume a coroutine on the next run
+        void post(std::coroutine_handle<> handle) {
+          {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _ready.push_back(handle);
+          }
+          _cv.notify_one();
+        }
+
+        // Call a function after a delay in ms
+        void schedule(uint32_t delayMs, std::function<void()> fn) {
+          {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _timers.push_back({Clock::now() + std::chrono::milliseconds(delayMs), std::move(fn)});
+          }
+          _cv.notify_one();
+        }
+
+        // Resume the ready coroutines and call the expired timers without waiting.
+        // Returns true if there is still some pending work (timers).
+        bool runOnce() {
+          std::deque<std::coroutine_handle<>> ready;
+          std::vector<std::function<void()>> expired;
+          bool pending;
+          {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _collect(ready, expired);
+            pending = !_timers.empty();
+          }
+          for (auto& fn : expired)
+            fn();
+          for (auto handle : ready)
+            handle.resume();
+          return pending || !expired.empty() || !ready.empty();
+        }
+
+        // Run until stop() is called, sleeping until a coroutine is posted or a timer expires
+        void run() {
+          _running = true;
+          while (_running) {
+            std::deque<std::coroutine_handle<>> ready;
+            std::vector<std::function<void()>> expired;
+            {
+              std::unique_lock<std::mutex> lock(_mutex);
+              // stop() is checked under the lock so that its notification cannot be missed
+              if (!_running)
+                break;
+              _collect(ready, expired);
+              if (ready.empty() && expired.empty()) {
+                if (_timers.empty()) {
+                  _cv.wait(lock);
+                } else {
+                  Clock::time_point next = _timers.front().deadline;
+                  for (const auto& timer : _timers)
+                    if (timer.deadline < next)
+                      next = timer.deadline;
+                  _cv.wait_until(lock, next);
+                }
+                continue;
+              }
+            }
+            for (auto& fn : expired)
+              fn();
+            for (auto handle : ready)
+              handle.resume();
+          }
+        }
+
+        // Stop run()
+        void stop() {
+          {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _running = false;
+          }
+          _cv.notify_one();
+        }
+
+      private:
+        typedef struct {
+            Clock::time_point deadline;
+            std::function<void()> fn;
+        } Timer;
+
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        std::deque<std::coroutine_handle<>> _ready;
+        std::vector<Timer> _timers;
+        std::atomic<bool> _running{false};
+
+        // must be called with _mutex held
+        void _collect(std::deque<std::coroutine_handle<>>& ready, std::vector<std::function<void()>>& expired) {
+          ready.swap(_ready);
+          const Clock::time_point now = Clock::now();
+          for (size_t i = 0; i < _timers.size();) {
+            if (_timers[i].deadline <= now) {
+              expired.push_back(std::move(_timers[i].fn));
+              _timers[i] = std::move(_timers.back());
+              _timers.pop_back();
+            } else {
+              i++;
+            }
+          }
+        }
+    };
+
+    // Result of a wait on a state: evaluates to true if one of the expected states was reached before the timeout
+    template <typename S>
+    struct StateResult {
+        // also true, without waiting, when the wait could not subscribe to the state changes
+        bool timeout;
+        // state reached, or current state on timeout
+        S state;
+        explicit operator bool() const { return !timeout; }
+    };
+
+    // Awaitable resumed as soon as the network state matches the mask, or after the timeout (0 for no timeout)
+    template <typename C>
+    class StateAwaiter {
+      public:
+        typedef typename C::State State;
+
+        StateAwaiter(C& espConnect, uint32_t mask, uint32_t timeoutMs) : _espConnect(espConnect), _mask(mask), _timeoutMs(timeoutMs) {}
+
+        bool await_ready() const { return _matches(_espConnect.getState()); }
+
+        bool await_suspend(std::coroutine_handle<Task::promise_type> handle) {
+          Executor* executor = handle.promise().executor;
+          _wait = std::make_shared<Wait>();
+          _wait->state = _espConnect.getState();
+
+          std::shared_ptr<Wait> wait = _wait;
+          // sync subscriber: the coroutine is posted to the executor as soon as the state changes
+          _wait->subscription = _espConnect.subscribe([wait, executor, handle](const typename C::Event& event) {
+            if (!wait->done.exchange(true)) {
+              wait->state = event.state;
+              executor->post(handle);
+            } }, _mask, true);
+
+          // the state might have changed before the subscription
+          const State current = _espConnect.getState();
+          if (_matches(current) && !_wait->done.exchange(true)) {
+            _wait->state = current;
+            return false;
+          }
+
+          // no subscription (ESPCONNECT_MAX_SUBSCRIBERS reached): nothing would resume the coroutine
+          if (!_wait->subscription) {
+            _wait->done = true;
+            _wait->timeout = true;
+            _wait->state = current;
+            return false;
+          }
+
+          if (_timeoutMs) {
+            C* espConnect = &_espConnect;
+            executor->schedule(_timeoutMs, [wait, executor, handle, espConnect]() {
+              if (!wait->done.exchange(true)) {
+                wait->timeout = true;
+                wait->state = espConnect->getState();
+                executor->post(handle);
+              }
+            });
+          }
+
+          return true;
+        }
+
+        StateResult<State> await_resume() {
+          if (!_wait)
+            return {false, _espConnect.getState()};
+          _espConnect.unsubscribe(_wait->subscription);
+          return {_wait->timeout, _wait->state};
+        }
+
+      private:
+        struct Wait {
+            std::atomic<bool> done{false};
+            bool timeout = false;
+            State state;
+            uint16_t subscription = 0;
+        };
+
+        C& _espConnect;
+        uint32_t _mask;
+        uint32_t _timeoutMs;
+        std::shared_ptr<Wait> _wait;
+
+        bool _matches(State state) const { return _mask & C::stateMask(state); }
+    };
+
+    // Wait until the state matches the mask (i.e. ESPConnect::stateMask(State::AP_STARTED) | ...), with an optional timeout in ms
+    template <typename C>
+    StateAwaiter<C> stateIn(C& espConnect, uint32_t mask, uint32_t timeoutMs = 0) {
+      return StateAwaiter<C>(espConnect, mask, timeoutMs);
+    }
+
+    // Wait until NETWORK_CONNECTED or NETWORK_READY (the network is up), with an optional timeout in ms
+    template <typename C>
+    StateAwaiter<C> connected(C& espConnect, uint32_t timeoutMs = 0) {
+      return StateAwaiter<C>(espConnect, C::stateMask(C::State::NETWORK_CONNECTED) | C::stateMask(C::State::NETWORK_READY), timeoutMs);
+    }
+
+    // Wait until NETWORK_READY (see ESPConnect::setReadinessChecks()), with an optional timeout in ms
+    template <typename C>
+    StateAwaiter<C> ready(C& espConnect, uint32_t timeoutMs = 0) {
+      return StateAwaiter<C>(espConnect, C::stateMask(C::State::NETWORK_READY), timeoutMs);
+    }
+
+  #if defined(ARDUINO) && !defined(ESP8266)
+    // Start an asynchronous WiFi scan and resume with the number of networks found (or WIFI_SCAN_FAILED),
+    // or with WIFI_SCAN_RUNNING if the scan did not complete before the timeout (0 for no timeout)
+    class ScanAwaiter {
+      public:
+        explicit ScanAwaiter(uint32_t timeoutMs) : _timeoutMs(timeoutMs) {}
+
+        bool await_ready() const { return false; }
+
+        bool await_suspend(std::coroutine_handle<Task::promise_type> handle) {
+          Executor* executor = handle.promise().executor;
+          _scan = std::make_shared<Scan>();
+          std::shared_ptr<Scan> scan = _scan;
+          // SCAN_DONE is also sent by the other scans (i.e. the ones of the captive portal) until the handler is removed:
+          // the coroutine is only posted once
+          _scan->eventId = WiFi.onEvent([scan, executor, handle](__unused WiFiEvent_t event, __unused WiFiEventInfo_t info) {
+            if (!scan->done.exchange(true))
+              executor->post(handle); }, ARDUINO_EVENT_WIFI_SCAN_DONE);
+          WiFi.scanDelete();
+          if (WiFi.scanNetworks(true) == WIFI_SCAN_FAILED) {
+            _scan->done = true;
+            return false;
+          }
+          if (_timeoutMs) {
+            executor->schedule(_timeoutMs, [scan, executor, handle]() {
+              if (!scan->done.exchange(true))
+                executor->post(handle);
+            });
+          }
+          return true;
+        }
+
+        int16_t await_resume() {
+          if (_scan)
+            WiFi.removeEvent(_scan->eventId);
+          return WiFi.scanComplete();
+        }
+
+      private:
+        struct Scan {
+            std::atomic<bool> done{false};
+            WiFiEventId_t eventId = 0;
+        };
+
+        uint32_t _timeoutMs;
+        std::shared_ptr<Scan> _scan;
+    };
+
+    // Scan with a timeout in ms (0 for no timeout)
+    inline ScanAwaiter scan(uint32_t timeoutMs = 15000) { return ScanAwaiter(timeoutMs); }
+  #endif
+  } // namespace Await
+} // namespace Mycila
+
+#endif
@@ -0,0 +1,421 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) Mathieu Carbou
+ */
+#pragma once
+
+// Improv-WiFi serial protocol (https://www.improv-wifi.com/serial/) and WIFI: URI parsing.
+//
+// This header only depends on the standard library so that the protocol, including the answers of the device,
+// can be exercised in a host build, for example through a pseudo-terminal on Linux.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <utility>
+
+#define ESPCONNECT_IMPROV_VERSION 1
+
+// maximum length of the data of a packet, also the maximum length of a line holding a WIFI: URI
+#ifndef ESPCONNECT_IMPROV_MAX_DATA
+  #define ESPCONNECT_IMPROV_MAX_DATA 128
+#endif
+
+// size of the URL of the device sent once provisioned: "http://255.255.255.255/"
+#define ESPCONNECT_IMPROV_URL_SIZE 24
+
+namespace Mycila {
+  namespace Improv {
+    enum class Type : uint8_t {
+      CURRENT_STATE = 0x01,
+      ERROR_STATE = 0x02,
+      RPC = 0x03,
+      RPC_RESULT = 0x04,
+    };
+
+    enum class State : uint8_t {
+      READY = 0x02,
+      PROVISIONING = 0x03,
+      PROVISIONED = 0x04,
+    };
+
+    enum class Error : uint8_t {
+      NONE = 0x00,
+      INVALID_RPC = 0x01,
+      UNKNOWN_RPC = 0x02,
+      UNABLE_TO_CONNECT = 0x03,
+      UNKNOWN = 0xFF,
+    };
+
+    enum class Command : uint8_t {
+      WIFI_SETTINGS = 0x01,
+      GET_CURRENT_STATE = 0x02,
+      GET_DEVICE_INFO = 0x03,
+      GET_WIFI_NETWORKS = 0x04,
+    };
+
+    typedef struct {
+        char ssid[33];
+        char password[65];
+        bool hidden;
+    } Credentials;
+
+    // Reads the Improv packets from a byte stream.
+    // The bytes which are not part of a packet are collected into lines, so that a WIFI: URI can also be sent as plain text.
+    class Parser {
+      public:
+        enum class Result {
+          NONE,
+          // a valid packet is available with type() and data()
+          PACKET,
+          // a line is available with line()
+          LINE,
+        };
+
+        Result feed(uint8_t c) {
+          // packet: "IMPROV" version type length data... checksum
+          if (_position < 6) {
+            if (c == "IMPROV"[_position]) {
+              _position++;
+              return Result::NONE;
+            }
+            // not a packet: the header bytes seen so far belong to the line
+            Result result = Result::NONE;
+            for (size_t i = 0; i < _position && result == Result::NONE; i++)
+              result = _feedLine("IMPROV"[i]);
+            _position = 0;
+            if (result != Result::NONE)
+              return result;
+            if (c == 'I') {
+              _position = 1;
+              return Result::NONE;
+            }
+            return _feedLine(c);
+          }
+
+          _packet[_position - 6] = c;
+          _position++;
+
+          // version, type and length
+          if (_position <= 9) {
+            if (_position == 7 && c != ESPCONNECT_IMPROV_VERSION)
+              _position = 0;
+            else if (_position == 9 && c > ESPCONNECT_IMPROV_MAX_DATA)
+              _position = 0;
+            return Result::NONE;
+          }
+
+          if (_position < 10 + static_cast<size_t>(_packet[2]))
+            return Result::NONE;
+
+          // checksum: sum of all the previous bytes of the packet
+          const size_t length = _packet[2];
+          _position = 0;
+          uint8_t checksum = static_cast<uint8_t>('I' + 'M' + 'P' + 'R' + 'O' + 'V');
+          for (size_t i = 0; i < 3 + length; i++)
+            checksum += _packet[i];
+          return checksum == c ? Result::PACKET : Result::NONE;
+        }
+
+        Type type() const { return static_cast<Type>(_packet[1]); }
+        const uint8_t* data() const { return _packet + 3; }
+        size_t length() const { return _packet[2]; }
+        const char* line() const { return _line; }
+
+      private:
+        // version, type, length, data, checksum
+        uint8_t _packet[3 + ESPCONNECT_IMPROV_MAX_DATA + 1] = {};
+        size_t _position = 0;
+        char _line[ESPCONNECT_IMPROV_MAX_DATA + 1] = {};
+        size_t _lineLength = 0;
+
+        Result _feedLine(char c) {
+          if (c == '\r' || c == '\n') {
+            if (!_lineLength)
+              return Result::NONE;
+            _line[_lineLength] = '\0';
+            _lineLength = 0;
+            return Result::LINE;
+          }
+          // too long: the line is dropped
+          if (_lineLength < ESPCONNECT_IMPROV_MAX_DATA)
+            _line[_lineLength++] = c;
+          return Result::NONE;
+        }
+    };
+
+    // Writes a packet into buffer and returns its size, or 0 if the buffer is too small
+    inline size_t encode(uint8_t* buffer, size_t size, Type type, const uint8_t* data, size_t length) {
+      if (length > 255 || size < 10 + length)
+        return 0;
+      memcpy(buffer, "IMPROV", 6);
+      buffer[6] = ESPCONNECT_IMPROV_VERSION;
+      buffer[7] = static_cast<uint8_t>(type);
+      buffer[8] = static_cast<uint8_t>(length);
+      if (length)
+        memcpy(buffer + 9, data, length);
+      uint8_t checksum = 0;
+      for (size_t i = 0; i < 9 + length; i++)
+        checksum += buffer[i];
+      buffer[9 + length] = checksum;
+      return 10 + length;
+    }
+
+    // Writes the data of a RPC result: command, length, then each string prefixed by its length.
+    // Returns the size of the data, or 0 if the buffer is too small.
+    inline size_t encodeResult(uint8_t* buffer, size_t size, Command command, const char* const* strings, size_t count) {
+      if (size < 2)
+        return 0;
+      size_t position = 2;
+      for (size_t i = 0; i < count; i++) {
+        const size_t len = strlen(strings[i]);
+        if (len > 255 || position + 1 + len > size)
+          return 0;
+        buffer[position++] = static_cast<uint8_t>(len);
+        memcpy(buffer + position, strings[i], len);
+        position += len;
+      }
+      if (position - 2 > 255)
+        return 0;
+      buffer[0] = static_cast<uint8_t>(command);
+      buffer[1] = static_cast<uint8_t>(position - 2);
+      return position;
+    }
+
+    // Parses the data of a WIFI_SETTINGS RPC: command, length, ssid length, ssid, password length, password
+    inline bool parseWiFiSettings(const uint8_t* data, size_t length, Credentials& credentials) {
+      if (length < 3 || data[0] != static_cast<uint8_t>(Command::WIFI_SETTINGS) || data[1] != length - 2)
+        return false;
+      const size_t ssidLength = data[2];
+      if (!ssidLength || ssidLength > 32 || 3 + ssidLength >= length)
+        return false;
+      const size_t passwordLength = data[3 + ssidLength];
+      if (passwordLength > 64 || 4 + ssidLength + passwordLength != length)
+        return false;
+      memcpy(credentials.ssid, data + 3, ssidLength);
+      credentials.ssid[ssidLength] = '\0';
+      memcpy(credentials.password, data + 4 + ssidLength, passwordLength);
+      credentials.password[passwordLength] = '\0';
+      credentials.hidden = false;
+      return true;
+    }
+
+    // Parses a WIFI:S:<ssid>;T:<WPA|WEP|nopass>;P:<password>;H:<true|false>;; URI, as found in WiFi QR codes.
+    // The fields can be in any order and \ escapes the special characters \ ; , : and ".
+    inline bool parseWiFiURI(const char* uri, Credentials& credentials) {
+      if (strncmp(uri, "WIFI:", 5) != 0)
+        return false;
+
+      memset(&credentials, 0, sizeof(credentials));
+      bool open = false;
+      const char* p = uri + 5;
+
+      while (*p && *p != ';') {
+        const char field = *p;
+        if (p[1] != ':')
+          return false;
+        p += 2;
+
+        char value[65];
+        size_t length = 0;
+        while (*p && *p != ';') {
+          if (*p == '\\' && p[1])
+            p++;
+          if (length == sizeof(value) - 1)
+            return false;
+          value[length++] = *p++;
+        }
+        if (*p != ';')
+          return false;
+        p++;
+        value[length] = '\0';
+
+        switch (field) {
+          case 'S':
+            if (length > 32)
+              return false;
+            memcpy(credentials.ssid, value, length + 1);
+            break;
+          case 'P':
+            memcpy(credentials.password, value, length + 1);
+            break;
+          case 'T':
+            open = strcmp(value, "nopass") == 0;
+            break;
+          case 'H':
+            credentials.hidden = strcmp(value, "true") == 0;
+            break;
+          default:
+            // unknown fields are ignored
+            break;
+        }
+      }
+
+      if (open)
+        credentials.password[0] = '\0';
+      return credentials.ssid[0] != '\0';
+    }
+
+    // Device side of the protocol: reads the bytes received on the serial port, answers the RPCs and the WIFI: lines,
+    // and reports the result of the credential test started by the provision callback.
+    // The serial port and the device specific answers are callbacks, so that the same code runs on the device and in a host test.
+    class Device {
+      public:
+        // writes a packet to the serial port
+        typedef std::function<void(const uint8_t* data, size_t length)> WriteCallback;
+        // starts the test of the credentials, returns false if they cannot be tested now
+        typedef std::function<bool(const Credentials& credentials)> ProvisionCallback;
+        // current state, with the URL of the device written into url when PROVISIONED
+        typedef std::function<State(char* url, size_t size)> StateCallback;
+        // fills firmware, version, chip family and hostname
+        typedef std::function<void(const char* info[4])> InfoCallback;
+        // calls sendNetwork() for each network of the last scan
+        typedef std::function<void()> NetworksCallback;
+
+        explicit Device(WriteCallback write) : _write(std::move(write)) {}
+
+        void onProvision(ProvisionCallback callback) { _provision = std::move(callback); }
+        void onState(StateCallback callback) { _state = std::move(callback); }
+        void onInfo(InfoCallback callback) { _info = std::move(callback); }
+        void onNetworks(NetworksCallback callback) { _networks = std::move(callback); }
+
+        void feed(uint8_t c) {
+          switch (_parser.feed(c)) {
+            case Parser::Result::LINE: {
+              Credentials credentials;
+              if (parseWiFiURI(_parser.line(), credentials))
+                _onCredentials(credentials);
+              break;
+            }
+            case Parser::Result::PACKET:
+              _onPacket();
+              break;
+            default:
+              break;
+          }
+        }
+
+        // credential test passed: the client offers to open the device web page
+        void provisioned(const char* url) {
+          const char* strings[] = {url};
+          sendState(State::PROVISIONED);
+          sendResult(Command::WIFI_SETTINGS, strings, 1);
+        }
+
+        // credential test failed: the client can send other credentials
+        void failed() {
+          sendError(Error::UNABLE_TO_CONNECT);
+          sendState(State::READY);
+        }
+
+        // credential test aborted, i.e. when the captive portal stops
+        void aborted() { sendError(Error::UNABLE_TO_CONNECT); }
+
+        // one result of GET_WIFI_NETWORKS
+        void sendNetwork(const char* ssid, int rssi, bool secured) {
+          char value[8];
+          snprintf(value, sizeof(value), "%d", rssi);
+          const char* strings[] = {ssid, value, secured ? "YES" : "NO"};
+          sendResult(Command::GET_WIFI_NETWORKS, strings, 3);
+        }
+
+        void send(Type type, const uint8_t* data, size_t length) {
+          uint8_t packet[10 + ESPCONNECT_IMPROV_MAX_DATA];
+          const size_t size = encode(packet, sizeof(packet), type, data, length);
+          if (size)
+            _write(packet, size);
+        }
+
+        void sendState(State state) {
+          const uint8_t data = static_cast<uint8_t>(state);
+          send(Type::CURRENT_STATE, &data, 1);
+        }
+
+        void sendError(Error error) {
+          const uint8_t data = static_cast<uint8_t>(error);
+          send(Type::ERROR_STATE, &data, 1);
+        }
+
+        void sendResult(Command command, const char* const* strings, size_t count) {
+          uint8_t data[ESPCONNECT_IMPROV_MAX_DATA];
+          const size_t length = encodeResult(data, sizeof(data), command, strings, count);
+          if (length)
+            send(Type::RPC_RESULT, data, length);
+        }
+
+      private:
+        Parser _parser;
+        WriteCallback _write;
+        ProvisionCallback _provision;
+        StateCallback _state;
+        InfoCallback _info;
+        NetworksCallback _networks;
+
+        void _onPacket() {
+          if (_parser.type() != Type::RPC || !_parser.length()) {
+            sendError(Error::INVALID_RPC);
+            return;
+          }
+
+          const Command command = static_cast<Command>(_parser.data()[0]);
+          switch (command) {
+            case Command::WIFI_SETTINGS: {
+              Credentials credentials;
+              if (parseWiFiSettings(_parser.data(), _parser.length(), credentials))
+                _onCredentials(credentials);
+              else
+                sendError(Error::INVALID_RPC);
+              break;
+            }
+
+            case Command::GET_CURRENT_STATE: {
+              char url[ESPCONNECT_IMPROV_URL_SIZE] = {0};
+              const State state = _state ? _state(url, sizeof(url)) : State::READY;
+              sendState(state);
+              if (state == State::PROVISIONED) {
+                const char* strings[] = {url};
+                sendResult(command, strings, 1);
+              }
+              break;
+            }
+
+            case Command::GET_DEVICE_INFO: {
+              const char* info[4] = {"", "", "", ""};
+              if (_info)
+                _info(info);
+              sendResult(command, info, 4);
+              break;
+            }
+
+            case Command::GET_WIFI_NETWORKS:
+              if (_networks)
+                _networks();
+              // end of the list
+              sendResult(command, nullptr, 0);
+              break;
+
+            default:
+              sendError(Error::UNKNOWN_RPC);
+              break;
+          }
+        }
+
+        void _onCredentials(const Credentials& credentials) {
+          // same rules as the captive portal
+          const size_t passwordLength = strlen(credentials.password);
+          if (!strlen(credentials.ssid) || (passwordLength && passwordLength < 8)) {
+            sendError(Error::INVALID_RPC);
+            return;
+          }
+          if (!_provision || !_provision(credentials)) {
+            sendError(Error::UNABLE_TO_CONNECT);
+            return;
+          }
+          sendError(Error::NONE);
+          sendState(State::PROVISIONING);
+        }
+    };
+  } // namespace Improv
+} // namespace Mycila
@@ -5,13 +5,16 @@
 #include "MycilaESPConnect.h"
 #include "MycilaESPConnect_Includes.h"
 #include "MycilaESPConnect_Logging.h"
+#include "MycilaESPConnect_Trace.h"
 
 void Mycila::ESPConnect::_startAP() {
   LOGI(TAG, "Starting Access Point...");
   _setState(Mycila::ESPConnect::State::AP_STARTING);
 
+  TRACE_BEGIN(TRACE_TRACK_WIFI, "radio_off");
   WiFi.disconnect(true);
   WiFi.mode(WIFI_MODE_NULL);
+  TRACE_END("radio_off");
 
 #ifndef ESP8266
   WiFi.softAPsetHostname(_config.hostname.c_str());
@@ -25,7 +28,9 @@ void Mycila::ESPConnect::_startAP() {
   WiFi.setAutoReconnect(false);
 
   WiFi.softAPConfig(IPAddress(192, 168, 4, 1), IPAddress(192, 168, 4, 1), IPAddress(255, 255, 255, 0));
+  TRACE_BEGIN(TRACE_TRACK_WIFI, "radio_init");
   WiFi.mode(WIFI_MODE_AP);
+  TRACE_END("radio_init");
 
   if (!_apPassword.length() || _apPassword.length() < 8) {
     // Disabling invalid Access Point password which must be at least 8 characters long when set
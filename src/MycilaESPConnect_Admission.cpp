@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) Mathieu Carbou
+ */
+#ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
+  #include "MycilaESPConnect.h"
+  #include "MycilaESPConnect_Includes.h"
+  #include "MycilaESPConnect_Logging.h"
+
+  #include <cstring>
+
+void Mycila::ESPConnect::setPortalAdmission(uint8_t maxConcurrent, uint8_t requestsPerSecond, uint8_t burst) {
+  _admissionMaxConcurrent = maxConcurrent;
+  _admissionRate = requestsPerSecond;
+  _admissionBurst = burst < 1 ? 1 : burst;
+  memset(_admissionBuckets, 0, sizeof(_admissionBuckets));
+}
+
+bool Mycila::ESPConnect::_admit(AsyncWebServerRequest* request, bool heavy) {
+  if (!_admissionRate && !_admissionMaxConcurrent)
+    return true;
+
+  const uint32_t now = millis();
+
+  if (_admissionRate) {
+    const uint32_t ip = static_cast<uint32_t>(request->client()->remoteIP());
+
+    // find the bucket of this client, or recycle the least recently used one
+    TokenBucket* bucket = &_admissionBuckets[0];
+    for (size_t i = 0; i < ESPCONNECT_ADMISSION_CLIENTS; i++) {
+      if (_admissionBuckets[i].ip == ip) {
+        bucket = &_admissionBuckets[i];
+        break;
+      }
+      if (now - _admissionBuckets[i].lastSeen > now - bucket->lastSeen)
+        bucket = &_admissionBuckets[i];
+    }
+    if (bucket->ip != ip) {
+      // a new or recycled client only gets the token of this request: the burst is earned at the refill rate,
+      // so cycling through addresses to evict the buckets cannot buy a full burst each time
+      bucket->ip = ip;
+      bucket->tokens = 1000;
+    } else {
+      // tokens are stored in 1/1000 to refill at ms resolution
+      const uint32_t max = _admissionBurst * 1000;
+      // a client idle long enough to fill its bucket is clamped before the multiplication, which would overflow after hours
+      const uint32_t elapsed = now - bucket->lastSeen;
+      const uint32_t refill = elapsed >= max / _admissionRate ? max : elapsed * _admissionRate;
+      bucket->tokens = refill >= max - bucket->tokens ? max : bucket->tokens + refill;
+    }
+    bucket->lastSeen = now;
+
+    if (bucket->tokens < 1000) {
+      _admissionStats.throttled++;
+      _reject(request);
+      return false;
+    }
+    bucket->tokens -= 1000;
+  }
+
+  if (heavy && _admissionMaxConcurrent) {
+    if (_admissionInFlight >= _admissionMaxConcurrent) {
+      _admissionStats.busy++;
+      _reject(request);
+      return false;
+    }
+    _admissionInFlight++;
+    // the response is complete when the client disconnects
+    request->onDisconnect([this]() { _admissionInFlight--; });
+  }
+
+  _admissionStats.admitted++;
+  return true;
+}
+
+void Mycila::ESPConnect::_reject(AsyncWebServerRequest* request) {
+  AsyncWebServerResponse* response = request->beginResponse(429);
+  response->addHeader("Retry-After", "1");
+  response->addHeader("Connection", "close");
+  request->send(response);
+}
+
+#endif
@@ -0,0 +1,171 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) Mathieu Carbou
+ */
+#include "MycilaESPConnect.h"
+#include "MycilaESPConnect_Includes.h"
+#include "MycilaESPConnect_Logging.h"
+
+#ifndef ESPCONNECT_NO_MDNS
+  #ifdef ESP8266
+    #include <ESP8266mDNS.h>
+  #else
+    #include <ESPmDNS.h>
+  #endif
+#endif
+
+#ifndef ESP8266
+  #include <esp_netif_net_stack.h>
+  #include <lwip/dhcp.h>
+  #include <lwip/tcpip.h>
+#endif
+
+#include <utility>
+
+#ifndef ESP8266
+// Renew the DHCP lease without releasing the IP address: the DHCP request carries the new hostname
+static void _renewDHCP(esp_netif_t* netif) {
+  if (netif == nullptr)
+    return;
+  struct netif* lwip = static_cast<struct netif*>(esp_netif_get_netif_impl(netif));
+  if (lwip == nullptr)
+    return;
+  tcpip_callback([](void* ctx) {
+    struct netif* lwip = static_cast<struct netif*>(ctx);
+    if (netif_dhcp_data(lwip) != nullptr)
+      dhcp_renew(lwip); }, lwip);
+}
+#endif
+
+uint8_t Mycila::ESPConnect::applyConfig(Config config) {
+  uint8_t changes = 0;
+  if (config.hostname != _config.hostname)
+    changes |= CONFIG_HOSTNAME;
+  if (config.ipConfig.ip != _config.ipConfig.ip || config.ipConfig.subnet != _config.ipConfig.subnet || config.ipConfig.gateway != _config.ipConfig.gateway)
+    changes |= CONFIG_IP;
+  if (config.ethIPConfig.ip != _config.ethIPConfig.ip || config.ethIPConfig.subnet != _config.ethIPConfig.subnet || config.ethIPConfig.gateway != _config.ethIPConfig.gateway)
+    changes |= CONFIG_IP;
+  if (config.ipConfig.dns != _config.ipConfig.dns || config.ethIPConfig.dns != _config.ethIPConfig.dns)
+    changes |= CONFIG_DNS;
+  if (config.wifiSSID != _config.wifiSSID || config.wifiPassword != _config.wifiPassword || config.wifiBSSID != _config.wifiBSSID)
+    changes |= CONFIG_WIFI;
+  if (config.apMode != _config.apMode)
+    changes |= CONFIG_AP_MODE;
+
+  if (!changes)
+    return changes;
+
+  _config = std::move(config);
+
+  if (_autoSave)
+    saveConfiguration();
+
+  if (_state == Mycila::ESPConnect::State::NETWORK_DISABLED)
+    return changes;
+
+  const bool ap = _state == Mycila::ESPConnect::State::AP_STARTING || _state == Mycila::ESPConnect::State::AP_STARTED;
+#ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
+  const bool portal = _state == Mycila::ESPConnect::State::PORTAL_STARTING || _state == Mycila::ESPConnect::State::PORTAL_STARTED || _state == Mycila::ESPConnect::State::PORTAL_COMPLETE || _state == Mycila::ESPConnect::State::PORTAL_TIMEOUT;
+#else
+  const bool portal = false;
+#endif
+
+  // switching between AP and STA, or new credentials while the AP or the portal is up: restart the state machine
+  if ((changes & CONFIG_AP_MODE) || ((ap || portal) && (changes & CONFIG_WIFI))) {
+    LOGI(TAG, "Applying new configuration: restarting network");
+#ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
+    if (portal)
+      _stopCaptivePortal(true);
+#endif
+    if (ap)
+      _stopAP();
+    _lastTime = -1;
+    _setState(Mycila::ESPConnect::State::NETWORK_ENABLED);
+    return changes;
+  }
+
+  // NETWORK_ENABLED: the new configuration is used by the next loop()
+  if (_state == Mycila::ESPConnect::State::NETWORK_ENABLED)
+    return changes;
+
+  if (changes & CONFIG_IP) {
+    LOGI(TAG, "Applying new configuration: IP");
+    // a static IP is probed again before being used
+#ifdef ESPCONNECT_ETH_SUPPORT
+    _setIPConfig(Mycila::ESPConnect::Mode::ETH, ETH.linkUp());
+#endif
+    if (!ap && !portal)
+#ifdef ESP8266
+      _setIPConfig(Mycila::ESPConnect::Mode::STA, WiFi.isConnected());
+#else
+      _setIPConfig(Mycila::ESPConnect::Mode::STA, WiFi.STA.connected());
+#endif
+  } else if (changes & CONFIG_DNS) {
+    // the DNS server does not need the address to be probed again
+    LOGI(TAG, "Applying new configuration: DNS");
+#ifdef ESPCONNECT_ETH_SUPPORT
+    _setDNS(Mycila::ESPConnect::Mode::ETH);
+#endif
+    if (!ap && !portal)
+      _setDNS(Mycila::ESPConnect::Mode::STA);
+  }
+
+  if (changes & CONFIG_HOSTNAME) {
+    LOGI(TAG, "Applying new configuration: hostname %s", _config.hostname.c_str());
+    WiFi.setHostname(_config.hostname.c_str());
+#ifndef ESP8266
+    if (ap || portal) {
+      WiFi.softAPsetHostname(_config.hostname.c_str());
+    } else {
+      WiFi.STA.setHostname(_config.hostname.c_str());
+      _renewDHCP(WiFi.STA.netif());
+    }
+  #ifdef ESPCONNECT_ETH_SUPPORT
+    ETH.setHostname(_config.hostname.c_str());
+    _renewDHCP(ETH.netif());
+  #endif
+#endif
+#ifndef ESPCONNECT_NO_MDNS
+    if (isConnected()) {
+      MDNS.end();
+      MDNS.begin(_config.hostname.c_str());
+    }
+#endif
+  }
+
+  if ((changes & CONFIG_WIFI) && !ap && !portal)
+    _reassociate();
+
+  return changes;
+}
+
+void Mycila::ESPConnect::_reassociate() {
+  // the radio is already in STA mode: only disconnect from the current AP and connect to the new one
+  if (!(WiFi.getMode() & WIFI_MODE_STA) || !_config.wifiSSID.length()) {
+    _setState(Mycila::ESPConnect::State::NETWORK_ENABLED);
+    return;
+  }
+
+  LOGI(TAG, "Applying new configuration: connecting to SSID: %s", _config.wifiSSID.c_str());
+
+#ifdef ESPCONNECT_ETH_SUPPORT
+  // Ethernet stays the default interface
+  if (!ETH.hasIP())
+    _setState(Mycila::ESPConnect::State::NETWORK_CONNECTING);
+#else
+  _setState(Mycila::ESPConnect::State::NETWORK_CONNECTING);
+#endif
+
+  // the disconnection event must not reconnect to the previous AP
+  _reassociating = WiFi.isConnected();
+  WiFi.disconnect(false);
+  if (_config.wifiBSSID.length()) {
+    MacAddress bssid(MACType::MAC6);
+    bssid.fromString(_config.wifiBSSID.c_str());
+    WiFi.begin(_config.wifiSSID.c_str(), _config.wifiPassword.c_str(), 0, bssid);
+  } else {
+    WiFi.begin(_config.wifiSSID.c_str(), _config.wifiPassword.c_str());
+  }
+
+  _lastTime = millis();
+}
@@ -6,17 +6,42 @@
   #include "MycilaESPConnect.h"
   #include "MycilaESPConnect_Includes.h"
   #include "MycilaESPConnect_Logging.h"
+  #include "MycilaESPConnect_Trace.h"
   #include "espconnect_webpage.h"
 
+  #include <cinttypes>
+  #include <cstdio>
+  #include <algorithm>
+  #include <cstring>
+  #include <memory>
   #include <utility> // NOLINT
+  #include <vector>
+
+  #ifndef ESP8266
+    #include <esp_idf_version.h>
+    #include <esp_wifi.h>
+    // time in ms after which a scan started with esp_wifi_scan_start() is considered failed
+    #define ESPCONNECT_SCAN_TIMEOUT 15000
+  #endif
+
+  #ifndef ESPCONNECT_NO_CP_API
+    #ifndef ESP8266
+      #include <esp_idf_version.h>
+      #include <esp_netif.h>
+    #endif
+    // RFC 8908 Captive Portal API endpoint
+    #define ESPCONNECT_CP_API_PATH "/espconnect/captive"
+  #endif
 
 void Mycila::ESPConnect::_startCaptivePortal() {
   LOGI(TAG, "Starting Captive Portal...");
   _setState(Mycila::ESPConnect::State::PORTAL_STARTING);
 
+  TRACE_BEGIN(TRACE_TRACK_WIFI, "radio_off");
   if (WiFi.isConnected())
     WiFi.disconnect(true);
   WiFi.mode(WIFI_MODE_NULL);
+  TRACE_END("radio_off");
 
   #ifndef ESP8266
   WiFi.softAPsetHostname(_config.hostname.c_str());
@@ -31,7 +56,9 @@ void Mycila::ESPConnect::_startCaptivePortal() {
 
   // Configure AP with specific IP range so devices recognize it as a captive portal
   WiFi.softAPConfig(IPAddress(4, 3, 2, 1), IPAddress(4, 3, 2, 1), IPAddress(255, 255, 255, 0));
+  TRACE_BEGIN(TRACE_TRACK_WIFI, "radio_init");
   WiFi.mode(WIFI_MODE_APSTA);
+  TRACE_END("radio_init");
 
   if (!_apPassword.length() || _apPassword.length() < 8) {
     // Disabling invalid Access Point password which must be at least 8 characters long when set
@@ -39,6 +66,33 @@ void Mycila::ESPConnect::_startCaptivePortal() {
   } else
     WiFi.softAP(_apSSID.c_str(), _apPassword.c_str());
 
+  #ifndef ESPCONNECT_NO_CP_API
+  _advertiseCaptivePortalAPI();
+  #endif
+
+  _lastTime = millis();
+  _backgroundRetryStartedAt = 0;
+  _backgroundRetryConnected = false;
+  _backgroundRetryEndedAt = _lastTime;
+
+  if (_lazyCaptivePortal) {
+    // only the softAP beacons until a station associates
+    _portalIdleSince = _lastTime;
+    _portalStationsChanged = true;
+  } else {
+    _startPortalServices();
+  }
+
+  #ifdef ESP8266
+  _onWiFiEvent(ARDUINO_EVENT_WIFI_AP_START);
+  #endif
+
+  LOGI(TAG, "Captive Portal started.");
+}
+
+void Mycila::ESPConnect::_startPortalServices() {
+  LOGD(TAG, "Starting Captive Portal services...");
+
   if (_dnsServer == nullptr) {
     _dnsServer = new DNSServer();
     _dnsServer->setErrorReplyCode(DNSReplyCode::NoError);
@@ -49,7 +103,10 @@ void Mycila::ESPConnect::_startCaptivePortal() {
 
   if (_scanHandler == nullptr) {
     _scanHandler = &_httpd->on("/espconnect/scan", HTTP_GET, [&](AsyncWebServerRequest* request) {
-      int n = WiFi.scanComplete();
+      if (!_admit(request, false))
+        return;
+
+      int n = _scanComplete();
 
       if (n == WIFI_SCAN_RUNNING) {
         // scan still running ? wait...
@@ -67,14 +124,7 @@ void Mycila::ESPConnect::_startCaptivePortal() {
         JsonArray json = response->getRoot();
 
         // we have some results
-        for (int i = 0; i < n; ++i) {
-          JsonObject entry = json.add<JsonObject>();
-          entry["bssid"] = WiFi.BSSIDstr(i);
-          entry["name"] = WiFi.SSID(i);
-          entry["rssi"] = WiFi.RSSI(i);
-          entry["signal"] = _wifiSignalQuality(WiFi.RSSI(i));
-          entry["open"] = WiFi.encryptionType(i) == WIFI_AUTH_OPEN;
-        }
+        _scanResults(json, n);
 
         WiFi.scanDelete();
         response->setLength();
@@ -128,7 +178,7 @@ void Mycila::ESPConnect::_startCaptivePortal() {
         return;
       }
 
-      if (_pausedRequest.use_count()) {
+      if (_isCredentialTestPending()) {
         delete underTest;
         request->send(409, "application/json", "{\"message\":\"A connection test is already in progress. Please wait.\"}");
         return;
@@ -154,16 +204,38 @@ void Mycila::ESPConnect::_startCaptivePortal() {
   }
 
   if (_homeHandler == nullptr) {
-    _homeHandler = &_httpd->on("/", HTTP_GET, [](AsyncWebServerRequest* request) {
-      AsyncWebServerResponse* response = request->beginResponse(200, "text/html", ESPCONNECT_HTML, sizeof(ESPCONNECT_HTML));
-      response->addHeader("Content-Encoding", "gzip");
-      return request->send(response);
+    _homeHandler = &_httpd->on("/", HTTP_GET, [this](AsyncWebServerRequest* request) {
+      _sendPortalPage(request);
     });
     _homeHandler->setFilter([&](__unused AsyncWebServerRequest* request) {
       return _state == Mycila::ESPConnect::State::PORTAL_STARTED;
     });
   }
 
+  #ifdef ESPCONNECT_HTML_SPLIT
+  // the asset paths change with their content so they can be cached forever
+  if (_cssHandler == nullptr)
+    _cssHandler = &_httpd->on(ESPCONNECT_CSS_PATH, HTTP_GET, [this](AsyncWebServerRequest* request) {
+      _sendPortalAsset(request, "text/css", ESPCONNECT_CSS, sizeof(ESPCONNECT_CSS));
+    });
+  if (_jsHandler == nullptr)
+    _jsHandler = &_httpd->on(ESPCONNECT_JS_PATH, HTTP_GET, [this](AsyncWebServerRequest* request) {
+      _sendPortalAsset(request, "text/javascript", ESPCONNECT_JS, sizeof(ESPCONNECT_JS));
+    });
+  #endif
+
+  #ifndef ESPCONNECT_NO_CP_API
+  // RFC 8908 Captive Portal API: tells the clients in one request that they are captive and where the portal is
+  if (_captivePortalAPIHandler == nullptr)
+    _captivePortalAPIHandler = &_httpd->on(ESPCONNECT_CP_API_PATH, HTTP_GET, [this](AsyncWebServerRequest* request) {
+      char json[96];
+      snprintf(json, sizeof(json), "{\"captive\":%s,\"user-portal-url\":\"http://%s/\"}", _state == Mycila::ESPConnect::State::PORTAL_STARTED ? "true" : "false", WiFi.softAPIP().toString().c_str());
+      AsyncWebServerResponse* response = request->beginResponse(200, "application/captive+json", json);
+      response->addHeader("Cache-Control", "private");
+      request->send(response);
+    });
+  #endif
+
   #ifndef ESPCONNECT_NO_COMPAT_CP
   // Microsoft Windows connectivity check - redirects to logout.net to trigger captive portal detection
   if (_connecttestHandler == nullptr)
@@ -220,31 +292,180 @@ void Mycila::ESPConnect::_startCaptivePortal() {
     });
   #endif
 
-  _httpd->onNotFound([](AsyncWebServerRequest* request) {
-    AsyncWebServerResponse* response = request->beginResponse(200, "text/html", ESPCONNECT_HTML, sizeof(ESPCONNECT_HTML));
-    response->addHeader("Content-Encoding", "gzip");
-    return request->send(response);
+  _httpd->onNotFound([this](AsyncWebServerRequest* request) {
+    _sendPortalPage(request);
   });
 
   _httpd->begin();
 
-  #ifdef ESP8266
-  _onWiFiEvent(ARDUINO_EVENT_WIFI_AP_START);
-  #endif
+  _startHTTPSRejection();
 
-  LOGI(TAG, "Captive Portal started.");
-  _lastTime = millis();
+  // idle time does not count toward the portal timeout
+  if (_portalIdleSince) {
+    _lastTime += millis() - _portalIdleSince;
+    _portalIdleSince = 0;
+  }
+}
+
+void Mycila::ESPConnect::_sendPortalPage(AsyncWebServerRequest* request) {
+  if (!_admit(request, true))
+    return;
+
+  // ESPCONNECT_HTML is a gzip stream left open: it is closed with the scan results so that the page does not have to poll for them
+  // built once per scan result
+  std::shared_ptr<const std::vector<uint8_t>> tail = std::atomic_load(&_portalPageTail);
+  if (tail == nullptr) {
+    const int n = _scanComplete();
+    std::shared_ptr<std::vector<uint8_t>> built = std::make_shared<std::vector<uint8_t>>();
+    _buildPortalPageTail(*built, n);
+    tail = built;
+    // no cache while the scan is running: the next page gets its results
+    if (n >= 0)
+      std::atomic_store(&_portalPageTail, tail);
+  }
+
+  AsyncWebServerResponse* response = request->beginResponse("text/html", sizeof(ESPCONNECT_HTML) + tail->size(), [tail](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+    size_t len = 0;
+    if (index < sizeof(ESPCONNECT_HTML)) {
+      len = std::min(maxLen, sizeof(ESPCONNECT_HTML) - index);
+      memcpy_P(buffer, ESPCONNECT_HTML + index, len);
+    }
+    const size_t offset = index + len - sizeof(ESPCONNECT_HTML);
+    if (len < maxLen && offset < tail->size()) {
+      const size_t n = std::min(maxLen - len, tail->size() - offset);
+      memcpy(buffer + len, tail->data() + offset, n);
+      len += n;
+    }
+    return len;
+  });
+  response->addHeader("Content-Encoding", "gzip");
+  request->send(response);
+}
+
+void Mycila::ESPConnect::_sendPortalAsset(AsyncWebServerRequest* request, const char* contentType, const uint8_t* content, size_t len) {
+  if (!_admit(request, false))
+    return;
+  AsyncWebServerResponse* response = request->beginResponse(200, contentType, content, len);
+  response->addHeader("Content-Encoding", "gzip");
+  response->addHeader("Cache-Control", "public, max-age=31536000, immutable");
+  request->send(response);
+}
+
+void Mycila::ESPConnect::_scanResults(JsonArray json, int count) {
+  for (int i = 0; i < count; ++i) {
+    JsonObject entry = json.add<JsonObject>();
+    entry["bssid"] = WiFi.BSSIDstr(i);
+    entry["name"] = WiFi.SSID(i);
+    entry["rssi"] = WiFi.RSSI(i);
+    entry["signal"] = _wifiSignalQuality(WiFi.RSSI(i));
+    entry["open"] = WiFi.encryptionType(i) == WIFI_AUTH_OPEN;
+  }
+}
+
+static uint32_t _crc32(uint32_t crc, const uint8_t* data, size_t len) {
+  crc = ~crc;
+  while (len--) {
+    crc ^= *data++;
+    for (uint8_t k = 0; k < 8; k++)
+      crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
+
+void Mycila::ESPConnect::_buildPortalPageTail(std::vector<uint8_t>& tail, int count) {
+  String results;
+  if (count > 0) {
+    JsonDocument doc;
+    _scanResults(doc.to<JsonArray>(), count);
+    serializeJson(doc, results);
+  }
+
+  // final stored deflate block: 5 bytes header, then the script
+  tail.reserve(results.length() + 64);
+  tail.resize(5);
+  if (results.length()) {
+    static const char prefix[] = "<script>window.espconnectScan=";
+    static const char suffix[] = "</script>";
+    tail.insert(tail.end(), prefix, prefix + sizeof(prefix) - 1);
+    // an SSID must not be able to close the script element
+    for (const char* c = results.c_str(); *c; c++) {
+      if (*c == '<') {
+        static const char lt[] = "\\u003c";
+        tail.insert(tail.end(), lt, lt + sizeof(lt) - 1);
+      } else {
+        tail.push_back(static_cast<uint8_t>(*c));
+      }
+    }
+    tail.insert(tail.end(), suffix, suffix + sizeof(suffix) - 1);
+  }
+  const uint16_t size = tail.size() - 5;
+  tail[0] = 0x01; // BFINAL, stored
+  tail[1] = size & 0xFF;
+  tail[2] = size >> 8;
+  tail[3] = ~size & 0xFF;
+  tail[4] = (~size >> 8) & 0xFF;
+
+  // gzip trailer: CRC32 and size of the whole page
+  const uint32_t crc = _crc32(ESPCONNECT_HTML_CRC32, tail.data() + 5, size);
+  const uint32_t length = ESPCONNECT_HTML_LENGTH + size;
+  for (uint8_t i = 0; i < 4; i++)
+    tail.push_back((crc >> (8 * i)) & 0xFF);
+  for (uint8_t i = 0; i < 4; i++)
+    tail.push_back((length >> (8 * i)) & 0xFF);
+}
+
+void Mycila::ESPConnect::_backgroundRetry() {
+  const uint32_t now = millis();
+
+  if (_backgroundRetryStartedAt) {
+    if (now - _backgroundRetryStartedAt >= _backgroundRetryDuration * 1000) {
+      LOGD(TAG, "Background retry: SSID %s not reachable", _config.wifiSSID.c_str());
+      _backgroundRetryStartedAt = 0;
+      _backgroundRetryEndedAt = now;
+      // only disconnect the STA interface: the portal stays up
+      WiFi.disconnect(false);
+    }
+    return;
+  }
+
+  if (now - _backgroundRetryEndedAt < _backgroundRetryInterval * 1000)
+    return;
+
+  // The STA and the softAP share the radio: connecting to an AP on another channel moves the softAP to this channel.
+  // When a client is connected to the portal, only look for the configured WiFi on the softAP channel.
+  const int32_t channel = WiFi.softAPgetStationNum() ? WiFi.channel() : 0;
+  LOGI(TAG, "Background retry: connecting to SSID: %s (channel: %" PRId32 ")", _config.wifiSSID.c_str(), channel);
+
+  WiFi.setAutoReconnect(false);
+  if (_config.wifiBSSID.length()) {
+    MacAddress bssid(MACType::MAC6);
+    bssid.fromString(_config.wifiBSSID.c_str());
+    WiFi.begin(_config.wifiSSID.c_str(), _config.wifiPassword.c_str(), channel, bssid);
+  } else {
+    WiFi.begin(_config.wifiSSID.c_str(), _config.wifiPassword.c_str(), channel);
+  }
+
+  _backgroundRetryStartedAt = now ? now : 1;
+}
+
+Mycila::ESPConnect::Config* Mycila::ESPConnect::_credentialsUnderTest() {
+  if (_improvUnderTest != nullptr)
+    return _improvUnderTest;
+  if (auto request = _pausedRequest.lock())
+    return static_cast<Config*>(request->_tempObject);
+  return nullptr;
 }
 
 void Mycila::ESPConnect::_startCredentialTest() {
-  if (auto request = _pausedRequest.lock()) {
-    Config* underTest = static_cast<Config*>(request->_tempObject);
+  if (Config* underTest = _credentialsUnderTest()) {
     LOGI(TAG, "Testing WiFi credentials for SSID=%s, BSSID=%s", underTest->wifiSSID.c_str(), underTest->wifiBSSID.c_str());
 
     // Before trying to connect, make sure DNS server is stopped
     // Note: we do not restart it because we have already captured the device so the captive portal is already opened
     // No need also to delete: it will be deleted when stopping the captive portal
-    _dnsServer->stop();
+    // In lazy mode, the DNS server is not started until a station associates
+    if (_dnsServer != nullptr)
+      _dnsServer->stop();
 
     WiFi.persistent(false);
     WiFi.setAutoReconnect(false);
@@ -259,6 +480,9 @@ void Mycila::ESPConnect::_startCredentialTest() {
     }
 
     _credentialTestInProgress = millis();
+    // the credential test replaces any background attempt
+    _backgroundRetryStartedAt = 0;
+    _backgroundRetryEndedAt = _credentialTestInProgress;
 
   } else {
     // should never happen except if request is aborted at the same time we go there
@@ -267,49 +491,101 @@ void Mycila::ESPConnect::_startCredentialTest() {
 }
 
 void Mycila::ESPConnect::_processCredentialTest() {
-  if (auto request = _pausedRequest.lock()) {
-    switch (WiFi.status()) {
-      case WL_NO_SSID_AVAIL:
-      case WL_CONNECT_FAILED:
-      case WL_CONNECTION_LOST: {
-        LOGW(TAG, "WiFi credentials test failed with error: %d", WiFi.status());
-        _scan();
+  Config* underTest = _credentialsUnderTest();
+  if (underTest == nullptr) {
+    // should never happen except if request is aborted at the same time we go there
+    LOGE(TAG, "No paused request found for WiFi credential test.");
+    return;
+  }
+  const bool improv = _improvUnderTest != nullptr;
+
+  switch (WiFi.status()) {
+    case WL_NO_SSID_AVAIL:
+    case WL_CONNECT_FAILED:
+    case WL_CONNECTION_LOST: {
+      LOGW(TAG, "WiFi credentials test failed with error: %d", WiFi.status());
+  #ifdef ESPCONNECT_METRICS
+      _metrics.credentialTestsFailed++;
+  #endif
+      _scan();
+      if (improv) {
+        if (_improv != nullptr)
+          _improv->failed();
+      } else if (auto request = _pausedRequest.lock()) {
         request->send(400, "application/json", "{\"message\":\"WiFi connection failed. Check the SSID and password and try again.\"}");
-        _stopCredentialTest();
-        break;
       }
-      case WL_CONNECTED: {
-        LOGI(TAG, "WiFi credentials test successful!");
-        Config* underTest = static_cast<Config*>(request->_tempObject);
-        _config.wifiSSID = std::move(underTest->wifiSSID);
-        _config.wifiPassword = std::move(underTest->wifiPassword);
-        // Do not save bssid otherwise it will prevent the ESP to connect to another satellite in a mesh network.
-        // This is up to the user to update the config if it needs to be fixed
-        // _config.wifiBSSID = std::move(underTest->wifiBSSID);
+      _stopCredentialTest();
+      break;
+    }
+    case WL_CONNECTED: {
+      LOGI(TAG, "WiFi credentials test successful!");
+  #ifdef ESPCONNECT_METRICS
+      _metrics.credentialTestsPassed++;
+  #endif
+      _config.wifiSSID = std::move(underTest->wifiSSID);
+      _config.wifiPassword = std::move(underTest->wifiPassword);
+      // Do not save bssid otherwise it will prevent the ESP to connect to another satellite in a mesh network.
+      // This is up to the user to update the config if it needs to be fixed
+      // _config.wifiBSSID = std::move(underTest->wifiBSSID);
+      if (improv) {
+        if (_improv != nullptr) {
+          char url[ESPCONNECT_IMPROV_URL_SIZE];
+          snprintf(url, sizeof(url), "http://%s/", WiFi.localIP().toString().c_str());
+          _improv->provisioned(url);
+        }
+      } else if (auto request = _pausedRequest.lock()) {
         request->send(200, "application/json", "{\"message\":\"Configuration saved.\"}");
-        _stopCredentialTest();
-        _setState(Mycila::ESPConnect::State::PORTAL_COMPLETE);
-        break;
       }
-      default:
-        break;
+      _stopCredentialTest();
+      _setState(Mycila::ESPConnect::State::PORTAL_COMPLETE);
+      break;
     }
-
-  } else {
-    // should never happen except if request is aborted at the same time we go there
-    LOGE(TAG, "No paused request found for WiFi credential test.");
+    default:
+      // the portal request is timed out by the client, Improv has no timeout
+      if (improv && millis() - _credentialTestInProgress >= _connectTimeout * 1000) {
+        LOGW(TAG, "WiFi credentials test timed out");
+  #ifdef ESPCONNECT_METRICS
+        _metrics.credentialTestsFailed++;
+  #endif
+        if (_improv != nullptr)
+          _improv->failed();
+        _stopCredentialTest();
+      }
+      break;
   }
 }
 
 void Mycila::ESPConnect::_stopCredentialTest() {
   _credentialTestInProgress = 0;
   _pausedRequest.reset();
+  if (_improvUnderTest != nullptr) {
+    delete _improvUnderTest;
+    _improvUnderTest = nullptr;
+  }
 }
 
-void Mycila::ESPConnect::_stopCaptivePortal() {
+void Mycila::ESPConnect::_stopCaptivePortal(bool disconnect) {
   LOGI(TAG, "Stopping Captive Portal...");
   _lastTime = -1;
+  _backgroundRetryStartedAt = 0;
+  _portalIdleSince = 0;
+
+  if (_improvUnderTest != nullptr) {
+    if (_improv != nullptr)
+      _improv->aborted();
+    _stopCredentialTest();
+  }
+
+  _stopPortalServices();
 
+  if (disconnect)
+    WiFi.disconnect(true);
+  WiFi.softAPdisconnect(true);
+
+  LOGI(TAG, "Captive Portal stopped.");
+}
+
+void Mycila::ESPConnect::_stopPortalServices() {
   // In case we have to early stop the captive portal, notify the user first
   if (auto request = _pausedRequest.lock()) {
     request->send(400, "application/json", "{\"message\":\"Captive Portal stopped.\"}");
@@ -322,13 +598,15 @@ void Mycila::ESPConnect::_stopCaptivePortal() {
     _dnsServer = nullptr;
   }
 
-  WiFi.disconnect(true);
-  WiFi.softAPdisconnect(true);
-
   if (_homeHandler == nullptr)
     return;
 
+  LOGD(TAG, "Stopping Captive Portal services...");
+
+  _stopHTTPSRejection();
+
   WiFi.scanDelete();
+  std::atomic_store(&_portalPageTail, std::shared_ptr<const std::vector<uint8_t>>());
 
   _httpd->end();
   _httpd->onNotFound(nullptr);
@@ -348,6 +626,23 @@ void Mycila::ESPConnect::_stopCaptivePortal() {
     _homeHandler = nullptr;
   }
 
+  if (_cssHandler != nullptr) {
+    _httpd->removeHandler(_cssHandler);
+    _cssHandler = nullptr;
+  }
+
+  if (_jsHandler != nullptr) {
+    _httpd->removeHandler(_jsHandler);
+    _jsHandler = nullptr;
+  }
+
+  #ifndef ESPCONNECT_NO_CP_API
+  if (_captivePortalAPIHandler != nullptr) {
+    _httpd->removeHandler(_captivePortalAPIHandler);
+    _captivePortalAPIHandler = nullptr;
+  }
+  #endif
+
   #ifndef ESPCONNECT_NO_COMPAT_CP
   if (_connecttestHandler != nullptr) {
     _httpd->removeHandler(_connecttestHandler);
@@ -386,9 +681,39 @@ void Mycila::ESPConnect::_stopCaptivePortal() {
     _startpageHandler = nullptr;
   }
   #endif
+}
 
-  LOGI(TAG, "Captive Portal stopped.");
+void Mycila::ESPConnect::_updatePortalServices() {
+  _portalStationsChanged = false;
+  const bool stations = WiFi.softAPgetStationNum() > 0;
+  if (stations && _homeHandler == nullptr) {
+    LOGI(TAG, "Station connected to the Captive Portal");
+    _startPortalServices();
+  } else if (!stations && _homeHandler != nullptr) {
+    LOGI(TAG, "Last station left the Captive Portal");
+    _stopPortalServices();
+    _portalIdleSince = millis();
+  }
+}
+
+  #ifndef ESPCONNECT_NO_CP_API
+void Mycila::ESPConnect::_advertiseCaptivePortalAPI() {
+    #if !defined(ESP8266) && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+  // RFC 8910: DHCP option 114 advertises the Captive Portal API URI
+  esp_netif_t* netif = WiFi.AP.netif();
+  if (netif == nullptr)
+    return;
+  // the DHCP server keeps a pointer to the URI
+  snprintf(_captivePortalAPI, sizeof(_captivePortalAPI), "http://%s" ESPCONNECT_CP_API_PATH, WiFi.softAPIP().toString().c_str());
+  esp_netif_dhcps_stop(netif);
+  if (esp_netif_dhcps_option(netif, ESP_NETIF_OP_SET, ESP_NETIF_CAPTIVEPORTAL_URI, _captivePortalAPI, strlen(_captivePortalAPI)) != ESP_OK) {
+    LOGW(TAG, "Unable to set DHCP option 114");
+  }
+  esp_netif_dhcps_start(netif);
+  LOGD(TAG, "Captive Portal API: %s", _captivePortalAPI);
+    #endif
 }
+  #endif
 
 void Mycila::ESPConnect::toJson(const JsonObject& root) const {
   root["ip_address"] = getIPAddress().toString();
@@ -404,21 +729,97 @@ void Mycila::ESPConnect::toJson(const JsonObject& root) const {
   root["mac_address_ap"] = getMACAddress(Mycila::ESPConnect::Mode::AP);
   root["mac_address_eth"] = getMACAddress(Mycila::ESPConnect::Mode::ETH);
   root["mac_address_sta"] = getMACAddress(Mycila::ESPConnect::Mode::STA);
+  root["online"] = _online;
+  root["flaps"] = _flapCount;
   root["mode"] = getMode() == Mycila::ESPConnect::Mode::AP ? "AP" : (getMode() == Mycila::ESPConnect::Mode::STA ? "STA" : (getMode() == Mycila::ESPConnect::Mode::ETH ? "ETH" : "NONE"));
   root["state"] = getStateName();
   root["wifi_bssid"] = getWiFiBSSID();
   root["wifi_rssi"] = getWiFiRSSI();
   root["wifi_signal"] = getWiFiSignalQuality();
   root["wifi_ssid"] = getWiFiSSID();
+  root["ip_conflict_eth"] = hasIPConflict(Mycila::ESPConnect::Mode::ETH);
+  root["ip_conflict_sta"] = hasIPConflict(Mycila::ESPConnect::Mode::STA);
+  #ifndef ESP8266
+  root["gateway_rtt"] = getGatewayRTT();
+  root["scan_duration"] = _scanDuration;
+  #endif
+  #ifdef ESPCONNECT_WATCHDOG
+  root["escalation_level"] = getEscalationName(getEscalationLevel());
+  root["recoveries"] = _recoveries;
+  root["mttr"] = getMTTR();
+  #endif
+  #ifdef ESPCONNECT_DUTY_CYCLE
+  root["fast_wake"] = _fastWake;
+  root["radio_on_time"] = getRadioOnTime();
+  #endif
+  #ifdef ESPCONNECT_ETH_SUPPORT
+  root["eth_time_to_ip"] = _ethTimeToIP;
+  root["sta_time_to_ip"] = _staTimeToIP;
+  root["eth_link_speed"] = _ethLinkSpeed;
+  root["eth_full_duplex"] = _ethFullDuplex;
+  root["eth_link_up_time"] = _ethLinkUpTime;
+  #endif
 }
 
 void Mycila::ESPConnect::_scan() {
   WiFi.scanDelete();
+  std::atomic_store(&_portalPageTail, std::shared_ptr<const std::vector<uint8_t>>());
+  #ifdef ESPCONNECT_METRICS
+  _metrics.scans++;
+  #endif
   #ifndef ESP8266
-  WiFi.scanNetworks(true, false, false, 500, 0, nullptr, nullptr);
+  // ended on ARDUINO_EVENT_WIFI_SCAN_DONE
+  TRACE_BEGIN(TRACE_TRACK_WIFI, "scan");
+  _scanStartedAt = millis();
+  _scanBitmapAt = 0;
+  _scanPending = true;
+
+  uint16_t channels = _scanOptions.channels & ~SCAN_HISTORY;
+  if (_scanOptions.channels & SCAN_HISTORY)
+    channels |= _scanHistory;
+  const char* ssid = _scanOptions.ssid.length() ? _scanOptions.ssid.c_str() : nullptr;
+
+  // several channels: only esp_wifi_scan_start() accepts a channel mask, the results are collected by WiFiScanClass on ARDUINO_EVENT_WIFI_SCAN_DONE
+  if (channels & (channels - 1)) {
+    #if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)
+    wifi_scan_config_t config = {};
+    config.ssid = reinterpret_cast<uint8_t*>(const_cast<char*>(ssid));
+    config.scan_type = _scanOptions.passive ? WIFI_SCAN_TYPE_PASSIVE : WIFI_SCAN_TYPE_ACTIVE;
+    config.scan_time.active.min = _scanOptions.minDwell;
+    config.scan_time.active.max = _scanOptions.maxDwell;
+    config.scan_time.passive = _scanOptions.maxDwell;
+    config.channel_bitmap.ghz_2_channels = channels;
+    if (esp_wifi_scan_start(&config, false) == ESP_OK) {
+      _scanBitmapAt = _scanStartedAt;
+      return;
+    }
+    #endif
+    channels = 0;
+  }
+
+  WiFi.setScanActiveMinTime(_scanOptions.minDwell);
+  WiFi.scanNetworks(true, false, _scanOptions.passive, _scanOptions.maxDwell, channels ? __builtin_ctz(channels) : 0, ssid, nullptr);
   #else
   WiFi.scanNetworks(true);
   #endif
 }
 
+int16_t Mycila::ESPConnect::_scanComplete() {
+  const int16_t n = WiFi.scanComplete();
+  #ifndef ESP8266
+  if (n >= 0) {
+    _scanBitmapAt = 0;
+    if (_scanPending) {
+      _scanPending = false;
+      for (int16_t i = 0; i < n; i++)
+        _scanHistory |= 1 << WiFi.channel(i);
+    }
+  } else if (n == WIFI_SCAN_FAILED && _scanBitmapAt && millis() - _scanBitmapAt < ESPCONNECT_SCAN_TIMEOUT) {
+    // WiFiScanClass only knows about a scan started with esp_wifi_scan_start() once it completes
+    return WIFI_SCAN_RUNNING;
+  }
+  #endif
+  return n;
+}
+
 #endif
@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) Mathieu Carbou
+ */
+#ifdef ESPCONNECT_DUTY_CYCLE
+  #include "MycilaESPConnect.h"
+  #include "MycilaESPConnect_Includes.h"
+  #include "MycilaESPConnect_Logging.h"
+  #include "MycilaESPConnect_Trace.h"
+
+  #include <esp_netif.h>
+  #include <esp_netif_net_stack.h>
+  #include <esp_sleep.h>
+  #include <lwip/dhcp.h>
+  #include <lwip/tcpip.h>
+
+  #include <cinttypes>
+  #include <cstring>
+  #include <ctime>
+
+  // changed when the layout of RetainedState changes
+  #define ESPCONNECT_RETAINED_MAGIC 0xEC0D0001
+
+typedef struct {
+    // written last: ESPCONNECT_RETAINED_MAGIC when the state is valid
+    uint32_t magic;
+    // FNV-1a of the SSID and password the state belongs to
+    uint32_t network;
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint32_t ip;
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+    // system time in seconds when the lease of ip was obtained, and its duration in seconds (0: no lease)
+    time_t leaseStart;
+    uint32_t leaseTime;
+    // radio-on time in ms of the last wake, kept when the state is cleared
+    uint32_t radioOnTime;
+} RetainedState;
+
+// kept across deep sleep, cleared by a power-on or a reset
+RTC_DATA_ATTR static RetainedState _retained;
+
+static uint32_t _retainedNetwork(const char* ssid, const char* password) {
+  uint32_t hash = 2166136261UL;
+  while (*ssid) {
+    hash ^= static_cast<uint8_t>(*ssid++);
+    hash *= 16777619UL;
+  }
+  // separator: "ab" + "c" and "a" + "bc" are different networks
+  hash *= 16777619UL;
+  while (*password) {
+    hash ^= static_cast<uint8_t>(*password++);
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+void Mycila::ESPConnect::clearRetainedState() {
+  _retained.magic = 0;
+}
+
+uint32_t Mycila::ESPConnect::getRadioOnTime() const {
+  return _radioOnAt ? millis() - _radioOnAt : 0;
+}
+
+uint32_t Mycila::ESPConnect::getLastRadioOnTime() const {
+  return _retained.radioOnTime;
+}
+
+void Mycila::ESPConnect::deepSleep(uint64_t us) {
+  _retained.radioOnTime = getRadioOnTime();
+  LOGI(TAG, "Entering deep sleep: radio on for %" PRIu32 " ms", _retained.radioOnTime);
+  end();
+  if (us)
+    esp_sleep_enable_timer_wakeup(us);
+  esp_deep_sleep_start();
+}
+
+bool Mycila::ESPConnect::_startSTAFast() {
+  _leaseReused = false;
+  // only for the first connection after a wake from deep sleep
+  if (_radioOnAt || esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_UNDEFINED)
+    return false;
+  if (_retained.magic != ESPCONNECT_RETAINED_MAGIC || !_retained.channel || _retained.network != _retainedNetwork(_config.wifiSSID.c_str(), _config.wifiPassword.c_str()))
+    return false;
+
+  const time_t now = time(nullptr);
+  // a static IP is probed as usual
+  const bool lease = _staticIPConfig(Mycila::ESPConnect::Mode::STA) == nullptr && _retained.leaseTime && now >= _retained.leaseStart && now - _retained.leaseStart + ESPCONNECT_DUTY_CYCLE_LEASE_MARGIN < _retained.leaseTime;
+
+  _fastWakePending = true;
+  _fastWakeFailed = false;
+
+  // the radio is off after a deep sleep: no need to cycle it
+  WiFi.setScanMethod(WIFI_FAST_SCAN);
+  WiFi.setHostname(_config.hostname.c_str());
+  WiFi.setSleep(false);
+  WiFi.persistent(false);
+  WiFi.setAutoReconnect(true);
+
+  TRACE_BEGIN(TRACE_TRACK_WIFI, "radio_init");
+  _radioOnAt = millis();
+  WiFi.mode(WIFI_MODE_STA);
+  TRACE_END("radio_init");
+  WiFi.enableIPv6();
+
+  if (lease) {
+    // no DHCP exchange: the lease is reused until it expires
+    LOGI(TAG, "Fast wake: reusing IP: %s for %" PRIu32 " s", IPAddress(_retained.ip).toString().c_str(), static_cast<uint32_t>(_retained.leaseTime - (now - _retained.leaseStart)));
+    WiFi.config(IPAddress(_retained.ip), IPAddress(_retained.gateway), IPAddress(_retained.subnet), IPAddress(_retained.dns));
+    _leaseReused = true;
+  } else {
+    _setIPConfig(Mycila::ESPConnect::Mode::STA, false);
+  }
+
+  TRACE_BEGIN(TRACE_TRACK_WIFI, "association");
+  LOGI(TAG, "Fast wake: connecting to SSID: %s with BSSID: %02X:%02X:%02X:%02X:%02X:%02X on channel: %" PRIu8, _config.wifiSSID.c_str(), _retained.bssid[0], _retained.bssid[1], _retained.bssid[2], _retained.bssid[3], _retained.bssid[4], _retained.bssid[5], _retained.channel);
+  WiFi.begin(_config.wifiSSID.c_str(), _config.wifiPassword.c_str(), _retained.channel, _retained.bssid);
+
+  _lastTime = millis();
+  return true;
+}
+
+void Mycila::ESPConnect::_retainState() {
+  if (_fastWakePending) {
+    _fastWakePending = false;
+    _fastWake = true;
+    LOGI(TAG, "Fast wake: connected in %" PRIu32 " ms", getRadioOnTime());
+  }
+
+  const uint32_t network = _retainedNetwork(_config.wifiSSID.c_str(), _config.wifiPassword.c_str());
+  const uint32_t ip = static_cast<uint32_t>(WiFi.localIP());
+  const uint8_t* bssid = WiFi.BSSID();
+  if (bssid == nullptr)
+    return;
+
+  // the lease belongs to the IP address: it is kept when the retained lease was reused
+  const bool sameLease = _retained.magic == ESPCONNECT_RETAINED_MAGIC && _retained.network == network && _retained.ip == ip;
+  _retained.magic = 0;
+  _retained.network = network;
+  memcpy(_retained.bssid, bssid, sizeof(_retained.bssid));
+  _retained.channel = static_cast<uint8_t>(WiFi.channel());
+  _retained.ip = ip;
+  _retained.gateway = static_cast<uint32_t>(WiFi.gatewayIP());
+  _retained.subnet = static_cast<uint32_t>(WiFi.subnetMask());
+  _retained.dns = static_cast<uint32_t>(WiFi.dnsIP(0));
+  if (!sameLease)
+    _retained.leaseTime = 0;
+  _retained.magic = ESPCONNECT_RETAINED_MAGIC;
+
+  // lease obtained by the DHCP client, read from the TCP/IP thread
+  esp_netif_t* netif = WiFi.STA.netif();
+  struct netif* lwip = netif == nullptr ? nullptr : static_cast<struct netif*>(esp_netif_get_netif_impl(netif));
+  if (lwip == nullptr)
+    return;
+  tcpip_callback([](void* ctx) {
+    const struct dhcp* dhcp = netif_dhcp_data(static_cast<struct netif*>(ctx));
+    if (dhcp != nullptr && dhcp->state == DHCP_STATE_BOUND && dhcp->offered_t0_lease) {
+      _retained.leaseStart = time(nullptr);
+      _retained.leaseTime = dhcp->offered_t0_lease;
+    } }, lwip);
+}
+
+void Mycila::ESPConnect::_dutyCycleLoop() {
+  // the static configuration stopped the DHCP client: it is started again before the reused lease expires,
+  // so that the address is not kept past its lease when the device stays awake
+  if (_leaseReused && WiFi.isConnected() && time(nullptr) - _retained.leaseStart + ESPCONNECT_DUTY_CYCLE_LEASE_MARGIN / 2 >= _retained.leaseTime) {
+    LOGI(TAG, "Fast wake: reused lease expiring, starting DHCP");
+    _leaseReused = false;
+    esp_netif_t* netif = WiFi.STA.netif();
+    if (netif != nullptr)
+      esp_netif_dhcpc_start(netif);
+  }
+
+  if (!_fastWakePending)
+    return;
+  if (!_fastWakeFailed && millis() - _radioOnAt < ESPCONNECT_DUTY_CYCLE_TIMEOUT)
+    return;
+
+  LOGW(TAG, "Fast wake: %s, falling back to a normal connection", _fastWakeFailed ? "disconnected" : "timeout");
+  _fastWakePending = false;
+  clearRetainedState();
+  // the retained state is invalid: scan and DHCP
+  if (_state == Mycila::ESPConnect::State::NETWORK_CONNECTING)
+    _startSTA();
+}
+
+#endif
@@ -6,49 +6,171 @@
   #include "MycilaESPConnect.h"
   #include "MycilaESPConnect_Includes.h"
   #include "MycilaESPConnect_Logging.h"
+  #include "MycilaESPConnect_Trace.h"
+
+  #include <esp_netif.h>
+
+void Mycila::ESPConnect::setInterfacePolicy(Mycila::ESPConnect::Mode preferred, uint32_t gracePeriod) {
+  _preferredInterface = preferred == Mycila::ESPConnect::Mode::STA ? Mycila::ESPConnect::Mode::STA : Mycila::ESPConnect::Mode::ETH;
+  _interfaceGracePeriod = gracePeriod;
+}
+
+uint32_t Mycila::ESPConnect::getTimeToIP(Mycila::ESPConnect::Mode mode) const {
+  switch (mode) {
+    case Mycila::ESPConnect::Mode::ETH:
+      return _ethTimeToIP;
+    case Mycila::ESPConnect::Mode::STA:
+      return _staTimeToIP;
+    default:
+      return 0;
+  }
+}
+
+  #ifdef ESPCONNECT_ETH_TASK_PRIORITY
+// The Ethernet driver does not expose the priority of its receive task: it is changed once the task is created by ETH.begin()
+static void _setEthernetTaskPriority() {
+  for (const char* name : {"emac_rx", "w5500_tsk", "dm9051_tsk", "ksz8851snl_tsk"}) {
+    TaskHandle_t task = xTaskGetHandle(name);
+    if (task != nullptr)
+      vTaskPrioritySet(task, ESPCONNECT_ETH_TASK_PRIORITY);
+  }
+}
+  #endif
 
 void Mycila::ESPConnect::_startEthernet() {
-  _setState(Mycila::ESPConnect::State::NETWORK_CONNECTING);
+  // WiFi is up when only Ethernet is restarted by the watchdog
+  if (!_isNetworkUp())
+    _setState(Mycila::ESPConnect::State::NETWORK_CONNECTING);
+  _ethStartedAt = millis();
+  _ethTimeToIP = 0;
+  _lastTime = millis();
 
   #if defined(ETH_PHY_POWER) && ETH_PHY_POWER > -1
+  TRACE_BEGIN(TRACE_TRACK_ETH, "eth_phy_power");
   pinMode(ETH_PHY_POWER, OUTPUT);
     #ifdef ESPCONNECT_ETH_RESET_ON_START
+  // the PHY is powered and started from loop() once the reset delay has elapsed
   LOGD(TAG, "Resetting ETH_PHY_POWER Pin %d", ETH_PHY_POWER);
   digitalWrite(ETH_PHY_POWER, LOW);
-  delay(350);
+  _ethPhyResetAt = millis();
+  _ethPhyResetPending = true;
+  return;
     #endif
+  #endif
+
+  _beginEthernet();
+}
+
+void Mycila::ESPConnect::_beginEthernet() {
+  _ethPhyResetPending = false;
+
+  #if defined(ETH_PHY_POWER) && ETH_PHY_POWER > -1
   LOGD(TAG, "Activating ETH_PHY_POWER Pin %d", ETH_PHY_POWER);
   digitalWrite(ETH_PHY_POWER, HIGH);
+  TRACE_END("eth_phy_power");
   #endif
 
   LOGI(TAG, "Starting Ethernet...");
   bool success = true;
 
+  TRACE_BEGIN(TRACE_TRACK_ETH, "eth_begin");
+
+  #ifdef ESPCONNECT_ETH_TASK_STACK_SIZE
+  ETH.setTaskStackSize(ESPCONNECT_ETH_TASK_STACK_SIZE);
+  #endif
+
   #if defined(ESPCONNECT_ETH_SPI_SUPPORT)
   // https://github.com/espressif/arduino-esp32/tree/master/libraries/Ethernet/examples
   SPI.begin(ETH_PHY_SPI_SCK, ETH_PHY_SPI_MISO, ETH_PHY_SPI_MOSI);
   ETH.enableIPv6();
-  success = ETH.begin(ETH_PHY_TYPE, ETH_PHY_ADDR, ETH_PHY_CS, ETH_PHY_IRQ, ETH_PHY_RST, SPI);
+  success = ETH.begin(ETH_PHY_TYPE, ETH_PHY_ADDR, ETH_PHY_CS, ETH_PHY_IRQ, ETH_PHY_RST, SPI, ESPCONNECT_ETH_SPI_FREQ_MHZ);
   #else
   success = ETH.begin();
   #endif
+  TRACE_END("eth_begin");
 
   if (success) {
     LOGI(TAG, "Ethernet started.");
-    if (_config.ipConfig.ip) {
-      LOGI(TAG, "Set Ethernet Static IP Configuration:");
-      LOGI(TAG, " - IP: %s", _config.ipConfig.ip.toString().c_str());
-      LOGI(TAG, " - Gateway: %s", _config.ipConfig.gateway.toString().c_str());
-      LOGI(TAG, " - Subnet: %s", _config.ipConfig.subnet.toString().c_str());
-      LOGI(TAG, " - DNS: %s", _config.ipConfig.dns.toString().c_str());
-
-      ETH.config(_config.ipConfig.ip, _config.ipConfig.gateway, _config.ipConfig.subnet, _config.ipConfig.dns);
-    }
+  #ifdef ESPCONNECT_ETH_TASK_PRIORITY
+    _setEthernetTaskPriority();
+  #endif
+    _ethBegunAt = millis();
+    // PHY auto-negotiation, until ARDUINO_EVENT_ETH_CONNECTED
+    TRACE_BEGIN(TRACE_TRACK_ETH, "eth_link");
+    // a static IP is probed once the link is up (ARDUINO_EVENT_ETH_CONNECTED)
+    _setIPConfig(Mycila::ESPConnect::Mode::ETH, false);
   } else {
     LOGE(TAG, "ETH failed to start!");
   }
+}
 
-  _lastTime = millis();
+void Mycila::ESPConnect::_onEthernetLink(bool up) {
+  if (!up) {
+    _ethLinkSpeed = 0;
+    _ethFullDuplex = false;
+    _ethLinkUpTime = 0;
+    return;
+  }
+
+  // read once: the driver is queried through the PHY registers
+  _ethLinkSpeed = ETH.linkSpeed();
+  _ethFullDuplex = ETH.fullDuplex();
+  if (_ethBegunAt) {
+    _ethLinkUpTime = millis() - _ethBegunAt;
+    _ethBegunAt = 0;
+  }
+  LOGI(TAG, "Ethernet link up: %" PRIu16 " Mbps, %s duplex, in %" PRIu32 " ms", _ethLinkSpeed, _ethFullDuplex ? "full" : "half", _ethLinkUpTime);
+  if (!_ethFullDuplex) {
+    LOGW(TAG, "Ethernet link is half duplex: check the auto-negotiation of the switch port");
+  }
+}
+
+void Mycila::ESPConnect::_onInterfaceUp(Mycila::ESPConnect::Mode mode) {
+  const bool eth = mode == Mycila::ESPConnect::Mode::ETH;
+  const uint32_t now = millis();
+
+  uint32_t& startedAt = eth ? _ethStartedAt : _staStartedAt;
+  if (startedAt) {
+    (eth ? _ethTimeToIP : _staTimeToIP) = now - startedAt;
+    startedAt = 0;
+    LOGI(TAG, "%s got an IP address in %" PRIu32 " ms", eth ? "ETH" : "WiFi", getTimeToIP(mode));
+  }
+
+  if (!(eth ? WiFi.STA.hasIP() : ETH.hasIP())) {
+    // first interface up
+    _primaryInterface = mode;
+    _firstIPAt = now;
+  } else if (_primaryInterface != mode && mode == _preferredInterface && (!_interfaceGracePeriod || now - _firstIPAt <= _interfaceGracePeriod)) {
+    LOGI(TAG, "Switching default interface to %s", eth ? "ETH" : "WiFi");
+    _primaryInterface = mode;
+  #ifdef ESPCONNECT_METRICS
+    if (_isNetworkUp())
+      _metrics.failovers++;
+  #endif
+  }
+
+  // the IP events can also change the default interface of the network stack
+  esp_netif_set_default_netif(_primaryInterface == Mycila::ESPConnect::Mode::ETH ? ETH.netif() : WiFi.STA.netif());
+  _publishSnapshot();
+}
+
+void Mycila::ESPConnect::_onInterfaceDown(Mycila::ESPConnect::Mode mode) {
+  if (_primaryInterface != mode)
+    return;
+
+  const bool eth = mode == Mycila::ESPConnect::Mode::ETH;
+  if (eth ? WiFi.STA.hasIP() : ETH.hasIP()) {
+    LOGI(TAG, "Switching default interface to %s", eth ? "WiFi" : "ETH");
+    _primaryInterface = eth ? Mycila::ESPConnect::Mode::STA : Mycila::ESPConnect::Mode::ETH;
+    esp_netif_set_default_netif(eth ? WiFi.STA.netif() : ETH.netif());
+  #ifdef ESPCONNECT_METRICS
+    if (_isNetworkUp())
+      _metrics.failovers++;
+  #endif
+  } else {
+    _primaryInterface = Mycila::ESPConnect::Mode::NONE;
+  }
+  _publishSnapshot();
 }
 
 #endif
@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) Mathieu Carbou
+ */
+#include "MycilaESPConnect.h"
+#include "MycilaESPConnect_Includes.h"
+#include "MycilaESPConnect_Logging.h"
+
+#include <utility>
+
+#ifndef ESP8266
+  #define EVENTS_LOCK()        portENTER_CRITICAL(&_eventsLock)
+  #define EVENTS_UNLOCK()      portEXIT_CRITICAL(&_eventsLock)
+  #define SUBSCRIBERS_LOCK()   portENTER_CRITICAL(&_subscribersLock)
+  #define SUBSCRIBERS_UNLOCK() portEXIT_CRITICAL(&_subscribersLock)
+#else
+  #define EVENTS_LOCK()
+  #define EVENTS_UNLOCK()
+  #define SUBSCRIBERS_LOCK()
+  #define SUBSCRIBERS_UNLOCK()
+#endif
+
+uint16_t Mycila::ESPConnect::subscribe(EventCallback callback, uint32_t mask, bool sync) {
+  // the slot is reserved under the lock and the callback is moved outside of it: it can allocate
+  Subscriber* subscriber = nullptr;
+  SUBSCRIBERS_LOCK();
+  for (size_t i = 0; i < ESPCONNECT_MAX_SUBSCRIBERS; i++) {
+    if (!_subscribers[i].id && !_subscribers[i].reserved && !_subscribers[i].busy) {
+      subscriber = &_subscribers[i];
+      subscriber->reserved = true;
+      break;
+    }
+  }
+  SUBSCRIBERS_UNLOCK();
+
+  if (subscriber == nullptr) {
+    LOGE(TAG, "Unable to subscribe: ESPCONNECT_MAX_SUBSCRIBERS reached");
+    return 0;
+  }
+
+  subscriber->callback = std::move(callback);
+  subscriber->mask = mask;
+  subscriber->sync = sync;
+
+  SUBSCRIBERS_LOCK();
+  // 0 is reserved to mean "no subscription"
+  if (!++_lastSubscriberId)
+    ++_lastSubscriberId;
+  subscriber->id = _lastSubscriberId;
+  subscriber->reserved = false;
+  const uint16_t id = subscriber->id;
+  SUBSCRIBERS_UNLOCK();
+  return id;
+}
+
+void Mycila::ESPConnect::unsubscribe(uint16_t id) {
+  if (!id)
+    return;
+  Subscriber* subscriber = nullptr;
+  SUBSCRIBERS_LOCK();
+  for (size_t i = 0; i < ESPCONNECT_MAX_SUBSCRIBERS; i++) {
+    if (_subscribers[i].id == id) {
+      _subscribers[i].id = 0;
+      _subscribers[i].mask = 0;
+      // a callback being called (i.e. unsubscribing itself) is released when its slot is reused
+      if (!_subscribers[i].busy) {
+        subscriber = &_subscribers[i];
+        subscriber->reserved = true;
+      }
+      break;
+    }
+  }
+  SUBSCRIBERS_UNLOCK();
+
+  if (subscriber != nullptr) {
+    subscriber->callback = nullptr;
+    SUBSCRIBERS_LOCK();
+    subscriber->reserved = false;
+    SUBSCRIBERS_UNLOCK();
+  }
+}
+
+void Mycila::ESPConnect::_notifySubscribers(const Event& event, bool sync) {
+  const uint32_t mask = stateMask(event.state);
+  for (size_t i = 0; i < ESPCONNECT_MAX_SUBSCRIBERS; i++) {
+    Subscriber& subscriber = _subscribers[i];
+    SUBSCRIBERS_LOCK();
+    const bool call = subscriber.id && !subscriber.reserved && subscriber.sync == sync && (subscriber.mask & mask) && subscriber.callback != nullptr;
+    if (call)
+      subscriber.busy++;
+    SUBSCRIBERS_UNLOCK();
+
+    // no lock held: a slow async subscriber does not delay the sync ones called from the WiFi event task
+    if (call) {
+      subscriber.callback(event);
+      SUBSCRIBERS_LOCK();
+      subscriber.busy--;
+      SUBSCRIBERS_UNLOCK();
+    }
+  }
+}
+
+void Mycila::ESPConnect::_queueEvent(const Event& event) {
+  bool queued = false;
+  EVENTS_LOCK();
+  if (_eventsCount < ESPCONNECT_EVENT_QUEUE_SIZE) {
+    _events[(_eventsHead + _eventsCount) % ESPCONNECT_EVENT_QUEUE_SIZE] = event;
+    _eventsCount++;
+    queued = true;
+  }
+  EVENTS_UNLOCK();
+
+  if (!queued) {
+    LOGW(TAG, "Event queue full: dropping event %s => %s", getStateName(event.previous), getStateName(event.state));
+    return;
+  }
+
+#ifndef ESP8266
+  if (_eventTask != nullptr)
+    xTaskNotifyGive(_eventTask);
+#endif
+}
+
+void Mycila::ESPConnect::_dispatchEvents() {
+  while (true) {
+    Event event;
+    EVENTS_LOCK();
+    if (!_eventsCount) {
+      EVENTS_UNLOCK();
+      return;
+    }
+    event = _events[_eventsHead];
+    _eventsHead = (_eventsHead + 1) % ESPCONNECT_EVENT_QUEUE_SIZE;
+    _eventsCount--;
+    EVENTS_UNLOCK();
+
+    _notifySubscribers(event, false);
+  }
+}
+
+#ifndef ESP8266
+bool Mycila::ESPConnect::startEventTask(uint32_t stackSize, UBaseType_t priority, BaseType_t core) {
+  if (_eventTask != nullptr) {
+    if (!_eventTaskStopping)
+      return true;
+    LOGE(TAG, "Unable to create event task: the previous one is stopping");
+    return false;
+  }
+  _eventTaskStopping = false;
+  // left given by a task stopped from one of its subscribers
+  xSemaphoreTake(_eventTaskStopped, 0);
+  if (xTaskCreatePinnedToCore(_eventTaskLoop, "espconnect", stackSize, this, priority, &_eventTask, core) != pdPASS) {
+    LOGE(TAG, "Unable to create event task");
+    _eventTask = nullptr;
+    return false;
+  }
+  // dispatch the events that were queued before the task started
+  xTaskNotifyGive(_eventTask);
+  return true;
+}
+
+void Mycila::ESPConnect::stopEventTask() {
+  TaskHandle_t task = _eventTask;
+  if (task == nullptr || _eventTaskStopping)
+    return;
+  // the task is not killed: it ends after the dispatch in progress so that no callback is interrupted and no event is lost
+  _eventTaskStopping = true;
+  xTaskNotifyGive(task);
+  // called from a subscriber: the task ends after this callback
+  if (xTaskGetCurrentTaskHandle() == task)
+    return;
+  xSemaphoreTake(_eventTaskStopped, portMAX_DELAY);
+}
+
+void Mycila::ESPConnect::_eventTaskLoop(void* params) {
+  ESPConnect* self = static_cast<ESPConnect*>(params);
+  while (!self->_eventTaskStopping) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    self->_dispatchEvents();
+  }
+  // the events left are dispatched from loop() again
+  self->_eventTask = nullptr;
+  xSemaphoreGive(self->_eventTaskStopped);
+  vTaskDelete(nullptr);
+}
+#endif
@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) Mathieu Carbou
+ */
+#ifndef ESP8266
+  #include "MycilaESPConnect.h"
+  #include "MycilaESPConnect_Includes.h"
+  #include "MycilaESPConnect_Logging.h"
+
+  #include <esp_netif.h>
+  #include <esp_netif_net_stack.h>
+  #include <lwip/def.h>
+  #include <lwip/icmp.h>
+  #include <lwip/inet_chksum.h>
+  #include <lwip/raw.h>
+  #include <lwip/tcpip.h>
+
+  #include <cstring>
+
+  // identifier of the echo requests sent to the gateway
+  #define ESPCONNECT_GATEWAY_MONITOR_ID 0xEC01
+
+void Mycila::ESPConnect::setGatewayMonitor(uint32_t interval, uint32_t window) {
+  _stopGatewayMonitor();
+  _gatewayMonitorWindow = window;
+  // at least 2 pings during the window
+  _gatewayMonitorInterval = interval && window ? (interval < window / 2 ? interval : window / 2) : 0;
+}
+
+void Mycila::ESPConnect::_stopGatewayMonitor() {
+  if (!_gatewayMonitor.running)
+    return;
+  _gatewayMonitor.running = false;
+  tcpip_callback([](void* ctx) {
+    GatewayMonitor* monitor = static_cast<GatewayMonitor*>(ctx);
+    if (monitor->pcb != nullptr) {
+      raw_remove(static_cast<struct raw_pcb*>(monitor->pcb));
+      monitor->pcb = nullptr;
+    } }, &_gatewayMonitor);
+}
+
+void Mycila::ESPConnect::_gatewayMonitorLoop() {
+  if (!_gatewayMonitorInterval)
+    return;
+
+  GatewayMonitor& monitor = _gatewayMonitor;
+
+  // Ethernet is not monitored: a lost association is only a WiFi issue
+  if (!_isNetworkUp() || getMode() != Mycila::ESPConnect::Mode::STA || !WiFi.STA.hasIP()) {
+    _stopGatewayMonitor();
+    return;
+  }
+
+  const uint32_t now = millis();
+
+  if (!monitor.running) {
+    esp_netif_t* netif = WiFi.STA.netif();
+    monitor.netif = netif == nullptr ? nullptr : esp_netif_get_netif_impl(netif);
+    monitor.gateway = static_cast<uint32_t>(WiFi.STA.gatewayIP());
+    if (monitor.netif == nullptr || !monitor.gateway)
+      return;
+    monitor.replyAt = now;
+    monitor.rtt = 0;
+    // first ping right now
+    monitor.sentAt = now - _gatewayMonitorInterval;
+    monitor.running = true;
+
+    tcpip_callback([](void* ctx) {
+      GatewayMonitor* monitor = static_cast<GatewayMonitor*>(ctx);
+      struct raw_pcb* pcb = raw_new(IP_PROTO_ICMP);
+      if (pcb == nullptr)
+        return;
+      raw_bind_netif(pcb, static_cast<struct netif*>(monitor->netif));
+      raw_recv(pcb, [](void* arg, __unused struct raw_pcb* pcb, struct pbuf* p, const ip_addr_t* addr) -> uint8_t {
+        GatewayMonitor* monitor = static_cast<GatewayMonitor*>(arg);
+        // the payload starts with the IP header
+        uint8_t versionAndLength;
+        struct icmp_echo_hdr echo;
+        if (pbuf_copy_partial(p, &versionAndLength, 1, 0) != 1)
+          return 0;
+        if (pbuf_copy_partial(p, &echo, sizeof(echo), (versionAndLength & 0x0f) * 4) != sizeof(echo))
+          return 0;
+        // other ICMP packets go to the stack
+        if (ICMPH_TYPE(&echo) != ICMP_ER || echo.id != PP_HTONS(ESPCONNECT_GATEWAY_MONITOR_ID) || ip4_addr_get_u32(ip_2_ip4(addr)) != monitor->gateway)
+          return 0;
+        const uint32_t now = millis();
+        // a late reply to a previous ping proves that the gateway is alive, but its round-trip time is unknown
+        if (lwip_ntohs(echo.seqno) == monitor->seq)
+          monitor->rtt = now - monitor->sentAt;
+        monitor->replyAt = now;
+        pbuf_free(p);
+        return 1; }, monitor);
+      monitor->pcb = pcb; }, &monitor);
+  }
+
+  // replyAt can be more recent than now
+  const uint32_t replyAt = monitor.replyAt;
+  const uint32_t silence = static_cast<int32_t>(now - replyAt) > 0 ? now - replyAt : 0;
+
+  if (silence >= _gatewayMonitorWindow) {
+    LOGW(TAG, "Gateway %s unreachable for %" PRIu32 " ms: reconnecting WiFi", IPAddress(monitor.gateway).toString().c_str(), silence);
+    _stopGatewayMonitor();
+    _gatewayLost = true;
+    // the disconnection goes through the usual reconnect path of _onWiFiEvent()
+    WiFi.disconnect(false);
+    return;
+  }
+
+  // the last ping had the time to get a reply: ping faster until the gateway answers again
+  const uint32_t interval = silence > _gatewayMonitorInterval + ESPCONNECT_GATEWAY_MONITOR_FAST_INTERVAL ? ESPCONNECT_GATEWAY_MONITOR_FAST_INTERVAL : _gatewayMonitorInterval;
+  if (now - monitor.sentAt < interval)
+    return;
+
+  monitor.sentAt = now;
+  monitor.seq++;
+
+  tcpip_callback([](void* ctx) {
+    GatewayMonitor* monitor = static_cast<GatewayMonitor*>(ctx);
+    if (monitor->pcb == nullptr)
+      return;
+    struct pbuf* p = pbuf_alloc(PBUF_IP, sizeof(struct icmp_echo_hdr), PBUF_RAM);
+    if (p == nullptr)
+      return;
+    struct icmp_echo_hdr* echo = static_cast<struct icmp_echo_hdr*>(p->payload);
+    memset(echo, 0, sizeof(struct icmp_echo_hdr));
+    ICMPH_TYPE_SET(echo, ICMP_ECHO);
+    ICMPH_CODE_SET(echo, 0);
+    echo->id = PP_HTONS(ESPCONNECT_GATEWAY_MONITOR_ID);
+    echo->seqno = lwip_htons(monitor->seq);
+    echo->chksum = inet_chksum(echo, sizeof(struct icmp_echo_hdr));
+    ip_addr_t gateway;
+    ip_addr_set_ip4_u32(&gateway, monitor->gateway);
+    raw_sendto(static_cast<struct raw_pcb*>(monitor->pcb), p, &gateway);
+    pbuf_free(p); }, &monitor);
+}
+
+#endif
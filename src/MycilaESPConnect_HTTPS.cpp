@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) Mathieu Carbou
+ */
+#ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
+  #include "MycilaESPConnect.h"
+  #include "MycilaESPConnect_Includes.h"
+  #include "MycilaESPConnect_Logging.h"
+
+void Mycila::ESPConnect::_startHTTPSRejection() {
+  if (!_httpsMaxPerSecond || _httpsServer != nullptr)
+    return;
+
+  LOGD(TAG, "Rejecting HTTPS connections on %s:443", WiFi.softAPIP().toString().c_str());
+
+  // only listen on the softAP interface
+  _httpsServer = new AsyncServer(WiFi.softAPIP(), 443);
+  _httpsServer->setNoDelay(true);
+  _httpsServer->onClient([this](__unused void* arg, AsyncClient* client) {
+    const uint32_t now = millis();
+    if (now - _httpsWindowStart >= 1000) {
+      _httpsWindowStart = now;
+      _httpsWindowCount = 0;
+    }
+    // too many connections: the listener is paused from loop() and lwIP resets the connections by itself
+    if (++_httpsWindowCount > _httpsMaxPerSecond && !_httpsPausedAt)
+      _httpsPausedAt = now ? now : 1;
+  #ifdef ESPCONNECT_METRICS
+    _metrics.httpsRejected++;
+  #endif
+    // RST instead of FIN: the client gives up immediately and the PCB is freed without TIME_WAIT
+    client->onDisconnect([](__unused void* arg, AsyncClient* c) { delete c; });
+    client->abort(); }, nullptr);
+  _httpsServer->begin();
+  _httpsPausedAt = 0;
+  _httpsListening = true;
+}
+
+void Mycila::ESPConnect::_stopHTTPSRejection() {
+  if (_httpsServer == nullptr)
+    return;
+  _httpsServer->end();
+  delete _httpsServer;
+  _httpsServer = nullptr;
+  _httpsPausedAt = 0;
+  _httpsListening = false;
+}
+
+void Mycila::ESPConnect::_throttleHTTPSRejection() {
+  if (_httpsServer == nullptr || !_httpsPausedAt)
+    return;
+
+  if (_httpsListening) {
+    LOGD(TAG, "Too many HTTPS connections: pausing listener");
+    _httpsServer->end();
+    _httpsListening = false;
+  #ifdef ESPCONNECT_METRICS
+    _metrics.httpsThrottled++;
+  #endif
+    return;
+  }
+
+  if (millis() - _httpsPausedAt >= 1000) {
+    _httpsPausedAt = 0;
+    _httpsWindowCount = 0;
+    _httpsServer->begin();
+    _httpsListening = true;
+  }
+}
+
+#endif
@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) Mathieu Carbou
+ */
+#include "MycilaESPConnect.h"
+#include "MycilaESPConnect_Includes.h"
+#include "MycilaESPConnect_Logging.h"
+
+#include <cstdio>
+
+bool Mycila::ESPConnect::parseWiFiURI(const char* uri, Config& config) {
+  Improv::Credentials credentials;
+  if (uri == nullptr || !Improv::parseWiFiURI(uri, credentials))
+    return false;
+  config.wifiSSID = credentials.ssid;
+  config.wifiPassword = credentials.password;
+  return true;
+}
+
+#ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
+
+  #if defined(ESP8266)
+    #define ESPCONNECT_CHIP_FAMILY "ESP8266"
+  #elif defined(CONFIG_IDF_TARGET_ESP32S2)
+    #define ESPCONNECT_CHIP_FAMILY "ESP32-S2"
+  #elif defined(CONFIG_IDF_TARGET_ESP32S3)
+    #define ESPCONNECT_CHIP_FAMILY "ESP32-S3"
+  #elif defined(CONFIG_IDF_TARGET_ESP32C3)
+    #define ESPCONNECT_CHIP_FAMILY "ESP32-C3"
+  #elif defined(CONFIG_IDF_TARGET_ESP32C6)
+    #define ESPCONNECT_CHIP_FAMILY "ESP32-C6"
+  #elif defined(CONFIG_IDF_TARGET_ESP32H2)
+    #define ESPCONNECT_CHIP_FAMILY "ESP32-H2"
+  #else
+    #define ESPCONNECT_CHIP_FAMILY "ESP32"
+  #endif
+
+void Mycila::ESPConnect::setImprovSerial(Stream* serial, const char* firmware, const char* version) {
+  _improvSerial = serial;
+  if (serial == nullptr) {
+    _improv.reset();
+    return;
+  }
+
+  _improv.reset(new Improv::Device([serial](const uint8_t* data, size_t length) { serial->write(data, length); }));
+
+  _improv->onProvision([this](const Improv::Credentials& credentials) { return _improvProvision(credentials.ssid, credentials.password); });
+
+  _improv->onState([this](char* url, size_t size) {
+    if (_isCredentialTestPending())
+      return Improv::State::PROVISIONING;
+    if (_isNetworkUp() && WiFi.isConnected()) {
+      snprintf(url, size, "http://%s/", WiFi.localIP().toString().c_str());
+      return Improv::State::PROVISIONED;
+    }
+    return Improv::State::READY;
+  });
+
+  _improv->onInfo([this, firmware, version](const char* info[4]) {
+    info[0] = firmware;
+    info[1] = version;
+    info[2] = ESPCONNECT_CHIP_FAMILY;
+    info[3] = _config.hostname.c_str();
+  });
+
+  // networks from the last scan of the captive portal
+  _improv->onNetworks([this]() {
+    const int n = _scanComplete();
+    for (int i = 0; i < n; i++)
+      _improv->sendNetwork(WiFi.SSID(i).c_str(), WiFi.RSSI(i), WiFi.encryptionType(i) != WIFI_AUTH_OPEN);
+  });
+}
+
+void Mycila::ESPConnect::_improvLoop() {
+  while (_improvSerial->available() > 0) {
+    const int c = _improvSerial->read();
+    if (c < 0)
+      return;
+    _improv->feed(static_cast<uint8_t>(c));
+  }
+}
+
+bool Mycila::ESPConnect::_improvProvision(const char* ssid, const char* password) {
+  // credentials are only tested while the captive portal is started, one test at a time
+  if (_state != Mycila::ESPConnect::State::PORTAL_STARTED || _isCredentialTestPending()) {
+    LOGW(TAG, "Improv: cannot test WiFi credentials in state %s", getStateName());
+    return false;
+  }
+
+  LOGI(TAG, "Improv: received WiFi credentials for SSID=%s", ssid);
+
+  _improvUnderTest = new Config();
+  _improvUnderTest->wifiSSID = ssid;
+  _improvUnderTest->wifiPassword = password;
+  // the test is started from loop(), like the one of the captive portal
+  return true;
+}
+
+#endif
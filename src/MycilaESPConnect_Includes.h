@@ -11,6 +11,7 @@
   #define WIFI_MODE_APSTA                     WIFI_AP_STA
   #define WIFI_MODE_NULL                      WIFI_OFF
   #define WIFI_AUTH_OPEN                      ENC_TYPE_NONE
+  #define ARDUINO_EVENT_WIFI_STA_CONNECTED    WIFI_EVENT_STAMODE_CONNECTED
   #define ARDUINO_EVENT_WIFI_STA_GOT_IP       WIFI_EVENT_STAMODE_GOT_IP
   #define ARDUINO_EVENT_WIFI_STA_LOST_IP      WIFI_EVENT_STAMODE_DHCP_TIMEOUT
   #define ARDUINO_EVENT_WIFI_STA_DISCONNECTED WIFI_EVENT_STAMODE_DISCONNECTED
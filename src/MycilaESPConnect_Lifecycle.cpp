@@ -5,6 +5,7 @@
 #include "MycilaESPConnect.h"
 #include "MycilaESPConnect_Includes.h"
 #include "MycilaESPConnect_Logging.h"
+#include "MycilaESPConnect_Trace.h"
 
 #ifndef ESPCONNECT_NO_MDNS
   #ifdef ESP8266
@@ -14,22 +15,32 @@
   #endif
 #endif
 
+#ifdef ESP8266
+  #include <coredecls.h>
+#endif
+
 #include <utility>
 
-void Mycila::ESPConnect::begin(const char* hostname, const char* apSSID, const char* apPassword) {
+// maximum time between two loop() calls while begin() is blocking, state changes wake it up earlier
+#define ESPCONNECT_BLOCKING_LOOP_INTERVAL 100
+
+Mycila::ESPConnect::State Mycila::ESPConnect::begin(const char* hostname, const char* apSSID, const char* apPassword) {
   if (_state != Mycila::ESPConnect::State::NETWORK_DISABLED)
-    return;
+    return _state;
 
   _autoSave = true;
   Config config;
   loadConfiguration(config);
   config.hostname = hostname == nullptr ? "" : hostname;
-  begin(apSSID, apPassword, std::move(config));
+  return begin(apSSID, apPassword, std::move(config));
 }
 
-void Mycila::ESPConnect::begin(const char* apSSID, const char* apPassword, Mycila::ESPConnect::Config config) {
+Mycila::ESPConnect::State Mycila::ESPConnect::begin(const char* apSSID, const char* apPassword, Mycila::ESPConnect::Config config) {
   if (_state != Mycila::ESPConnect::State::NETWORK_DISABLED)
-    return;
+    return _state;
+
+  // ended when the network is ready (NETWORK_CONNECTED, AP_STARTED or PORTAL_STARTED)
+  TRACE_BEGIN(TRACE_TRACK_LIFECYCLE, "connect");
 
   _apSSID = apSSID;
   _apPassword = apPassword;
@@ -39,27 +50,90 @@ void Mycila::ESPConnect::begin(const char* apSSID, const char* apPassword, Mycil
   onStationModeGotIP = WiFi.onStationModeGotIP([this](__unused const WiFiEventStationModeGotIP& event) {
     this->_onWiFiEvent(ARDUINO_EVENT_WIFI_STA_GOT_IP);
   });
+  onStationModeConnected = WiFi.onStationModeConnected([this](__unused const WiFiEventStationModeConnected& event) {
+    this->_onWiFiEvent(ARDUINO_EVENT_WIFI_STA_CONNECTED);
+  });
   onStationModeDHCPTimeout = WiFi.onStationModeDHCPTimeout([this]() {
     this->_onWiFiEvent(ARDUINO_EVENT_WIFI_STA_LOST_IP);
   });
-  onStationModeDisconnected = WiFi.onStationModeDisconnected([this](__unused const WiFiEventStationModeDisconnected& event) {
-    this->_onWiFiEvent(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+  onStationModeDisconnected = WiFi.onStationModeDisconnected([this](const WiFiEventStationModeDisconnected& event) {
+    this->_onWiFiEvent(ARDUINO_EVENT_WIFI_STA_DISCONNECTED, event.reason);
+  });
+  #ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
+  onSoftAPModeStationConnected = WiFi.onSoftAPModeStationConnected([this](__unused const WiFiEventSoftAPModeStationConnected& event) {
+    this->_portalStationsChanged = true;
+  });
+  onSoftAPModeStationDisconnected = WiFi.onSoftAPModeStationDisconnected([this](__unused const WiFiEventSoftAPModeStationDisconnected& event) {
+    this->_portalStationsChanged = true;
   });
+  #endif
 #else
-  _wifiEventListenerId = WiFi.onEvent(std::bind(&ESPConnect::_onWiFiEvent, this, std::placeholders::_1));
+  _wifiEventListenerId = WiFi.onEvent([this](WiFiEvent_t event, WiFiEventInfo_t info) {
+    this->_onWiFiEvent(event, event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED ? info.wifi_sta_disconnected.reason : 0);
+  });
+#endif
+
+#ifdef ESPCONNECT_METRICS
+  _metrics.stateSince = millis();
+#endif
+
+#ifdef ESPCONNECT_WATCHDOG
+  _loadEscalations();
+  _watchdogSince = millis();
 #endif
 
   _state = Mycila::ESPConnect::State::NETWORK_ENABLED;
+  _publishSnapshot();
 
   // blocks like the old behaviour
   if (_blocking) {
     LOGI(TAG, "Starting ESPConnect in blocking mode...");
-    while (_state != Mycila::ESPConnect::State::AP_STARTED && _state != Mycila::ESPConnect::State::NETWORK_CONNECTED) {
-      loop();
-      delay(100);
+    return _waitReady();
+  }
+
+  LOGI(TAG, "Starting ESPConnect in non-blocking mode...");
+  return _state;
+}
+
+Mycila::ESPConnect::State Mycila::ESPConnect::_waitReady() {
+  const uint32_t start = millis();
+#ifndef ESP8266
+  // discard a signal from a previous state change
+  xSemaphoreTake(_stateSignal, 0);
+#endif
+
+  while (true) {
+    loop();
+
+    // NETWORK_DISABLED: nothing to start (no SSID and no captive portal)
+    if (_state == Mycila::ESPConnect::State::AP_STARTED || _state == Mycila::ESPConnect::State::NETWORK_READY || _state == Mycila::ESPConnect::State::NETWORK_DISABLED)
+      return _state;
+#ifndef ESP8266
+    if (_state == Mycila::ESPConnect::State::NETWORK_CONNECTED && !_readinessChecks)
+      return _state;
+#else
+    if (_state == Mycila::ESPConnect::State::NETWORK_CONNECTED)
+      return _state;
+#endif
+
+    uint32_t wait = ESPCONNECT_BLOCKING_LOOP_INTERVAL;
+    if (_blockingTimeout) {
+      const uint32_t elapsed = millis() - start;
+      if (elapsed >= _blockingTimeout) {
+        LOGW(TAG, "Blocking timeout: continuing in non-blocking mode in state %s", getStateName());
+        return _state;
+      }
+      if (_blockingTimeout - elapsed < wait)
+        wait = _blockingTimeout - elapsed;
     }
-  } else {
-    LOGI(TAG, "Starting ESPConnect in non-blocking mode...");
+
+    // wait for the next state change, or for the next loop() to check the timeouts
+#ifdef ESP8266
+    const Mycila::ESPConnect::State state = _state;
+    esp_delay(wait, [this, state]() { return _state == state; });
+#else
+    xSemaphoreTake(_stateSignal, pdMS_TO_TICKS(wait));
+#endif
   }
 }
 
@@ -70,18 +144,86 @@ void Mycila::ESPConnect::end() {
   _lastTime = -1;
   _autoSave = false;
   _setState(Mycila::ESPConnect::State::NETWORK_DISABLED);
+#ifdef ESPCONNECT_ETH_SUPPORT
+  _ethPhyResetPending = false;
+#endif
+  // no loop() anymore to apply the hold-down
+  _setOnline(false);
 #ifndef ESP8266
   WiFi.removeEvent(_wifiEventListenerId);
+  _stopGatewayMonitor();
+  _gatewayLost = false;
+#endif
+#ifdef ESPCONNECT_DUTY_CYCLE
+  _fastWakePending = false;
+  _leaseReused = false;
 #endif
   WiFi.disconnect(true, true);
   WiFi.mode(WIFI_MODE_NULL);
   _stopAP();
 #ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
+  #ifdef ESPCONNECT_METRICS
+  disableMetricsEndpoint();
+  #endif
   _httpd = nullptr;
 #endif
 }
 
 void Mycila::ESPConnect::loop() {
+  // deliver the pending events to the subscribers when there is no event task
+#ifndef ESP8266
+  if (_eventTask == nullptr)
+    _dispatchEvents();
+#else
+  _dispatchEvents();
+#endif
+
+  _debounce();
+
+#ifdef ESPCONNECT_METRICS
+  _sampleRSSI();
+#endif
+
+#ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
+  if (_improvSerial != nullptr)
+    _improvLoop();
+#endif
+
+#ifndef ESP8266
+  _arpProbeLoop(Mycila::ESPConnect::Mode::STA);
+  #ifdef ESPCONNECT_ETH_SUPPORT
+  _arpProbeLoop(Mycila::ESPConnect::Mode::ETH);
+  #endif
+#endif
+
+#ifndef ESP8266
+  _readinessLoop();
+  _gatewayMonitorLoop();
+#endif
+
+#ifdef ESPCONNECT_ADAPTIVE_TIMEOUT
+  // the time-to-IP is only sampled from the WiFi event task: NVS is not written from there
+  if (_timeToIPSample) {
+    const uint32_t ms = _timeToIPSample;
+    _timeToIPSample = 0;
+    _recordTimeToIP(ms);
+  }
+#endif
+
+#ifdef ESPCONNECT_WATCHDOG
+  _watchdogLoop();
+#endif
+
+#ifdef ESPCONNECT_DUTY_CYCLE
+  _dutyCycleLoop();
+#endif
+
+#ifdef ESPCONNECT_ETH_SUPPORT
+  // the PHY reset delay has elapsed: power the PHY and start Ethernet
+  if (_ethPhyResetPending && millis() - _ethPhyResetAt >= ESPCONNECT_ETH_RESET_DELAY)
+    _beginEthernet();
+#endif
+
   // Network has just been enable ?
   if (_state == Mycila::ESPConnect::State::NETWORK_ENABLED) {
     // AP Mode has higher priority
@@ -93,11 +235,13 @@ void Mycila::ESPConnect::loop() {
     // No AP mode ?
 
 #ifdef ESPCONNECT_ETH_SUPPORT
-    // If we have an ETH board, let's activate both ETH and WiFi if a SSID is configured
-    _startEthernet();
+    // If we have an ETH board, let's activate both ETH and WiFi if a SSID is configured.
+    // WiFi is started first so that the association runs while the Ethernet PHY starts: the first interface getting an IP wins.
+    _primaryInterface = Mycila::ESPConnect::Mode::NONE;
     if (_config.wifiSSID.length()) {
       _startSTA();
     }
+    _startEthernet();
     return;
 #else
     // No ETH board ? Then just start WiFi if a SSID is configured, otherwise start captive portal directly
@@ -124,6 +268,10 @@ void Mycila::ESPConnect::loop() {
       WiFi.config(static_cast<uint32_t>(0x00000000), static_cast<uint32_t>(0x00000000), static_cast<uint32_t>(0x00000000), static_cast<uint32_t>(0x00000000));
       WiFi.disconnect(true, true);
     } else {
+#ifdef ESPCONNECT_ADAPTIVE_TIMEOUT
+      // use the max timeout on the next attempt
+      _adaptiveMiss = getLearnedTimeToIP() != 0;
+#endif
       _lastTime = -1;
       _setState(Mycila::ESPConnect::State::NETWORK_TIMEOUT);
     }
@@ -149,31 +297,56 @@ void Mycila::ESPConnect::loop() {
 
 #ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
   if (_state == Mycila::ESPConnect::State::PORTAL_STARTED) {
+    // lazy mode: start or stop the portal services when the first station associates or the last one leaves
+    if (_lazyCaptivePortal && _portalStationsChanged)
+      _updatePortalServices();
+
+    // background retry succeeded: the portal services are stopped and the softAP is down before NETWORK_CONNECTED,
+    // so that the application can start its own web server from the state callback and the snapshot has the STA IP
+    if (_backgroundRetryConnected) {
+      _backgroundRetryConnected = false;
+      if (WiFi.isConnected()) {
+        _stopCaptivePortal(false);
+        WiFi.setAutoReconnect(true);
+        _setState(Mycila::ESPConnect::State::NETWORK_CONNECTED);
+        return;
+      }
+    }
+
+    _throttleHTTPSRejection();
+
     // timeout portal if we failed to connect to WiFi (we got a SSID) and portal duration is passed
     // in order to restart and try again to connect to the configured WiFi
-    if (_config.wifiSSID.length() && _durationPassed(_portalTimeout)) {
+    // with background retry, the portal stays up while the configured WiFi is retried
+    if (_config.wifiSSID.length() && !_backgroundRetryInterval && !_portalIdleSince && _durationPassed(_portalTimeout)) {
       _setState(Mycila::ESPConnect::State::PORTAL_TIMEOUT);
       return;
     }
 
     // Start WiFi credential test if we are in PORTAL_STARTED state and we have a paused request and not already testing credentials
-    if (_pausedRequest.use_count() && !_credentialTestInProgress) {
+    if (_isCredentialTestPending() && !_credentialTestInProgress) {
       _startCredentialTest();
       return;
     }
 
     // Process WiFi credential test results if we are in PORTAL_STARTED and we are currently testing credentials
-    // Note: this 5 sec delay is to avoid reading the WiFi status code that will not yet be updated after the begin call
-    if (_pausedRequest.use_count() && _credentialTestInProgress && (millis() - _credentialTestInProgress >= 5000)) {
+    // Note: this 5 sec delay is to avoid reading the WiFi status code that will not yet be updated after the begin call.
+    // A successful connection is reported as soon as it happens since the STA was not connected before the test.
+    if (_isCredentialTestPending() && _credentialTestInProgress && (WiFi.status() == WL_CONNECTED || millis() - _credentialTestInProgress >= 5000)) {
       _processCredentialTest();
       return;
     }
 
     // Stop WiFi credential test if we are in PORTAL_STARTED and we are currently testing credentials but the connection times out (10 sec)
-    if (!_pausedRequest.use_count() && _credentialTestInProgress) {
+    if (!_isCredentialTestPending() && _credentialTestInProgress) {
       _stopCredentialTest();
       return;
     }
+
+    if (_backgroundRetryInterval && _config.wifiSSID.length() && !_isCredentialTestPending()) {
+      _backgroundRetry();
+      return;
+    }
   }
 
   if (_state == Mycila::ESPConnect::State::PORTAL_TIMEOUT) {
@@ -215,8 +388,43 @@ void Mycila::ESPConnect::_setState(Mycila::ESPConnect::State state) {
 
   const Mycila::ESPConnect::State previous = _state;
   _state = state;
+  _publishSnapshot();
   LOGD(TAG, "State: %s => %s", getStateName(previous), getStateName(state));
 
+#ifdef ESPCONNECT_METRICS
+  const uint32_t now = millis();
+  _metrics.stateTime[static_cast<size_t>(previous)] += now - _metrics.stateSince;
+  _metrics.stateSince = now;
+  if (state == Mycila::ESPConnect::State::NETWORK_RECONNECTING)
+    _metrics.reconnects++;
+  #ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
+  if (state == Mycila::ESPConnect::State::PORTAL_STARTED)
+    _metrics.portalSessions++;
+  #endif
+#endif
+
+#ifdef ESPCONNECT_WATCHDOG
+  _watchdogOnState(previous, state);
+#endif
+
+  switch (state) {
+    case Mycila::ESPConnect::State::NETWORK_CONNECTED:
+      TRACE_END("connect");
+      TRACE_END("reconnect");
+      break;
+    case Mycila::ESPConnect::State::AP_STARTED:
+#ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
+    case Mycila::ESPConnect::State::PORTAL_STARTED:
+#endif
+      TRACE_END("connect");
+      break;
+    case Mycila::ESPConnect::State::NETWORK_DISCONNECTED:
+      TRACE_BEGIN(TRACE_TRACK_LIFECYCLE, "reconnect");
+      break;
+    default:
+      break;
+  }
+
 #ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
   // be sure to save anything before auto restart and callback
   if (_state == Mycila::ESPConnect::State::PORTAL_COMPLETE && _autoSave) {
@@ -224,15 +432,49 @@ void Mycila::ESPConnect::_setState(Mycila::ESPConnect::State state) {
   }
 #endif
 
+  const bool rawOnline = _isNetworkUp();
+  if (rawOnline != _rawOnline) {
+    _rawOnline = rawOnline;
+    _rawOnlineSince = millis();
+    // back to the debounced state before the hold-down expired
+    if (rawOnline == _online)
+      _flapCount++;
+  }
+
   // make sure callback is called before auto restart
   if (_callback != nullptr)
     _callback(previous, state);
+
+  Mycila::ESPConnect::Event event;
+  event.previous = previous;
+  event.state = state;
+  event.mode = getMode();
+  event.ip = getIPAddress(event.mode);
+  if (state == Mycila::ESPConnect::State::NETWORK_DISCONNECTED)
+    event.reason = _lastDisconnectReason;
+  else if (state == Mycila::ESPConnect::State::NETWORK_CONNECTED && _ipConflicts)
+    event.reason = REASON_IP_CONFLICT;
+  else
+    event.reason = 0;
+  _notifySubscribers(event, true);
+  // other subscribers are called asynchronously
+  _queueEvent(event);
+
+  // wake up a blocking begin()
+#ifdef ESP8266
+  esp_schedule();
+#else
+  xSemaphoreGive(_stateSignal);
+#endif
 }
 
-void Mycila::ESPConnect::_onWiFiEvent(WiFiEvent_t event) {
+void Mycila::ESPConnect::_onWiFiEvent(WiFiEvent_t event, uint16_t reason) {
   if (_state == Mycila::ESPConnect::State::NETWORK_DISABLED)
     return;
 
+  // the default interface or its IP address can change without any state change (i.e. Ethernet failover)
+  _publishSnapshot();
+
   switch (event) {
 #ifdef ESPCONNECT_ETH_SUPPORT
     case ARDUINO_EVENT_ETH_START:
@@ -242,43 +484,107 @@ void Mycila::ESPConnect::_onWiFiEvent(WiFiEvent_t event) {
       }
       break;
 
+    case ARDUINO_EVENT_ETH_CONNECTED:
+      LOGD(TAG, "[%s] WiFiEvent: ARDUINO_EVENT_ETH_CONNECTED", getStateName());
+      TRACE_END("eth_link");
+      _onEthernetLink(true);
+      _startArpProbe(Mycila::ESPConnect::Mode::ETH);
+      TRACE_BEGIN(TRACE_TRACK_ETH, "eth_dhcp");
+      break;
+
     case ARDUINO_EVENT_ETH_GOT_IP:
+      TRACE_END("eth_dhcp");
+      _onInterfaceUp(Mycila::ESPConnect::Mode::ETH);
   #ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
       if (_state == Mycila::ESPConnect::State::PORTAL_STARTING || _state == Mycila::ESPConnect::State::PORTAL_STARTED) {
         _setState(Mycila::ESPConnect::State::PORTAL_COMPLETE);
       }
   #endif
-      if (_state != Mycila::ESPConnect::State::NETWORK_CONNECTED && _state != Mycila::ESPConnect::State::NETWORK_DISABLED && _state != Mycila::ESPConnect::State::AP_STARTING && _state != Mycila::ESPConnect::State::AP_STARTED) {
+      if (!_isNetworkUp() && _state != Mycila::ESPConnect::State::NETWORK_DISABLED && _state != Mycila::ESPConnect::State::AP_STARTING && _state != Mycila::ESPConnect::State::AP_STARTED) {
         LOGD(TAG, "[%s] WiFiEvent: ARDUINO_EVENT_ETH_GOT_IP", getStateName());
 
         _lastTime = -1;
   #ifndef ESPCONNECT_NO_MDNS
+        TRACE_BEGIN(TRACE_TRACK_LIFECYCLE, "mdns");
         MDNS.begin(_config.hostname.c_str());
+        TRACE_END("mdns");
   #endif
         _setState(Mycila::ESPConnect::State::NETWORK_CONNECTED);
       }
       break;
     case ARDUINO_EVENT_ETH_DISCONNECTED:
-      if (_state == Mycila::ESPConnect::State::NETWORK_CONNECTED && !WiFi.STA.hasIP()) {
+      _onEthernetLink(false);
+      _stopArpProbe(Mycila::ESPConnect::Mode::ETH);
+      _onInterfaceDown(Mycila::ESPConnect::Mode::ETH);
+      if (_isNetworkUp() && !WiFi.STA.hasIP()) {
         LOGD(TAG, "[%s] WiFiEvent: ARDUINO_EVENT_ETH_DISCONNECTED", getStateName());
         _setState(Mycila::ESPConnect::State::NETWORK_DISCONNECTED);
       }
       break;
 #endif
 
+    case ARDUINO_EVENT_WIFI_STA_CONNECTED:
+      LOGD(TAG, "[%s] WiFiEvent: ARDUINO_EVENT_WIFI_STA_CONNECTED", getStateName());
+      _reassociating = false;
+      TRACE_END("association");
+      TRACE_BEGIN(TRACE_TRACK_WIFI, "dhcp");
+#ifndef ESP8266
+      _startArpProbe(Mycila::ESPConnect::Mode::STA);
+      // link-local address assignment including duplicate address detection, until ARDUINO_EVENT_WIFI_STA_GOT_IP6
+      TRACE_BEGIN(TRACE_TRACK_IPV6, "ipv6_dad");
+#endif
+      break;
+
     case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+      TRACE_END("dhcp");
       LOGD(TAG, "[%s] WiFiEvent: ARDUINO_EVENT_WIFI_STA_GOT_IP: %s", getStateName(), WiFi.localIP().toString().c_str());
+#ifdef ESPCONNECT_ETH_SUPPORT
+      _onInterfaceUp(Mycila::ESPConnect::Mode::STA);
+#endif
+#ifndef ESP8266
+      // channel hint of the next connection to this SSID
+      _channelHint = WiFi.channel();
+      _channelHintSSID = WiFi.SSID().c_str();
+      _scanHistory |= 1 << _channelHint;
+#endif
+#ifdef ESPCONNECT_DUTY_CYCLE
+      // connection state of the next wake from deep sleep
+      _retainState();
+#endif
+#ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
+      // the configured WiFi is back: the portal is stopped from loop() before NETWORK_CONNECTED
+      if (_state == Mycila::ESPConnect::State::PORTAL_STARTED && _backgroundRetryStartedAt) {
+        LOGI(TAG, "Background retry: connected to SSID: %s", _config.wifiSSID.c_str());
+        _backgroundRetryConnected = true;
+      }
+#endif
       if (_state == Mycila::ESPConnect::State::NETWORK_CONNECTING || _state == Mycila::ESPConnect::State::NETWORK_RECONNECTING) {
+#ifdef ESPCONNECT_ADAPTIVE_TIMEOUT
+  #ifdef ESPCONNECT_ETH_SUPPORT
+        // Ethernet is started after WiFi: _lastTime is the time when Ethernet was started
+        if (_state == Mycila::ESPConnect::State::NETWORK_CONNECTING && _staTimeToIP)
+          _timeToIPSample = _staTimeToIP;
+  #else
+        // _lastTime is the time when WiFi was started
+        if (_state == Mycila::ESPConnect::State::NETWORK_CONNECTING && _lastTime >= 0) {
+          const uint32_t ms = millis() - static_cast<uint32_t>(_lastTime);
+          _timeToIPSample = ms ? ms : 1;
+        }
+  #endif
+#endif
         _lastTime = -1;
         _setState(Mycila::ESPConnect::State::NETWORK_CONNECTED);
       }
 #ifndef ESPCONNECT_NO_MDNS
+      TRACE_BEGIN(TRACE_TRACK_LIFECYCLE, "mdns");
       MDNS.begin(_config.hostname.c_str());
+      TRACE_END("mdns");
 #endif
       break;
 
 #ifndef ESP8266
     case ARDUINO_EVENT_WIFI_STA_GOT_IP6:
+      TRACE_END("ipv6_dad");
       if (WiFi.linkLocalIPv6() != IN6ADDR_ANY) {
         if (WiFi.globalIPv6() == IN6ADDR_ANY) {
           LOGD(TAG, "[%s] WiFiEvent: ARDUINO_EVENT_WIFI_STA_GOT_IP6: Link-local: %s, global: <empty>", getStateName(), WiFi.linkLocalIPv6().toString().c_str());
@@ -291,10 +597,34 @@ void Mycila::ESPConnect::_onWiFiEvent(WiFiEvent_t event) {
 
     case ARDUINO_EVENT_WIFI_STA_LOST_IP:
     case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+      if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) {
+#ifndef ESP8266
+        // disconnection requested by the gateway monitor
+        _lastDisconnectReason = _gatewayLost ? REASON_GATEWAY_UNREACHABLE : reason;
+        _gatewayLost = false;
+#else
+        _lastDisconnectReason = reason;
+#endif
+#ifdef ESPCONNECT_METRICS
+        _countDisconnect(_lastDisconnectReason);
+#endif
+#ifdef ESPCONNECT_DUTY_CYCLE
+        // the fallback to the normal connection is done from loop()
+        if (_fastWakePending)
+          _fastWakeFailed = true;
+#endif
+      }
+#ifndef ESP8266
+      _stopArpProbe(Mycila::ESPConnect::Mode::STA);
+#endif
+#ifdef ESPCONNECT_ETH_SUPPORT
+      _onInterfaceDown(Mycila::ESPConnect::Mode::STA);
+#endif
       // try to reconnect to WiFi:
       // - if we have a SSID configured
       // - and if we are not in a first connecting phase that timed out
-      if (_config.wifiSSID.length()) {
+      // - and if the captive portal is not waiting for the next background retry
+      if (_config.wifiSSID.length() && !_isBackgroundRetryIdle()) {
         // when connecting timed out, prevent WiFi from reconnecting automatically as soon as we can
         if (_connectionTimeout()) {
           // log event
@@ -305,12 +635,15 @@ void Mycila::ESPConnect::_onWiFiEvent(WiFiEvent_t event) {
           }
           LOGD(TAG, "[%s] Immediately preventing WiFi from reconnecting automatically", getStateName());
           WiFi.setAutoReconnect(false);
+        } else if (_reassociating && event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) {
+          // _reassociate() is already connecting to the new AP
+          _reassociating = false;
         } else {
           // Ensure WiFi is trying to reconnect (required for older Arduino versions or platforms)
           WiFi.reconnect();
         }
       }
-      if (_state == Mycila::ESPConnect::State::NETWORK_CONNECTED) {
+      if (_isNetworkUp()) {
         // log event
         if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) {
           LOGD(TAG, "[%s] WiFiEvent: ARDUINO_EVENT_WIFI_STA_DISCONNECTED", getStateName());
@@ -327,6 +660,20 @@ void Mycila::ESPConnect::_onWiFiEvent(WiFiEvent_t event) {
       }
       break;
 
+#ifndef ESP8266
+    case ARDUINO_EVENT_WIFI_SCAN_DONE:
+      TRACE_END("scan");
+      if (_scanStartedAt) {
+        _scanDuration = millis() - _scanStartedAt;
+        _scanStartedAt = 0;
+        LOGD(TAG, "[%s] WiFiEvent: ARDUINO_EVENT_WIFI_SCAN_DONE in %" PRIu32 " ms", getStateName(), _scanDuration);
+  #ifdef ESPCONNECT_METRICS
+        _metrics.scanTime += _scanDuration;
+  #endif
+      }
+      break;
+#endif
+
     case ARDUINO_EVENT_WIFI_AP_START:
       if (_state == Mycila::ESPConnect::State::AP_STARTING) {
         LOGD(TAG, "[%s] WiFiEvent: ARDUINO_EVENT_WIFI_AP_START", getStateName());
@@ -341,11 +688,35 @@ void Mycila::ESPConnect::_onWiFiEvent(WiFiEvent_t event) {
 #endif
       break;
 
+#if !defined(ESP8266) && !defined(ESPCONNECT_NO_CAPTIVE_PORTAL)
+    case ARDUINO_EVENT_WIFI_AP_STACONNECTED:
+    case ARDUINO_EVENT_WIFI_AP_STADISCONNECTED:
+      // handled from loop()
+      _portalStationsChanged = true;
+      break;
+#endif
+
     default:
       break;
   }
 }
 
+void Mycila::ESPConnect::_debounce() {
+  if (_rawOnline == _online)
+    return;
+  if (millis() - _rawOnlineSince >= (_rawOnline ? _onlineHoldMs : _offlineHoldMs))
+    _setOnline(_rawOnline);
+}
+
+void Mycila::ESPConnect::_setOnline(bool online) {
+  if (_online == online)
+    return;
+  _online = online;
+  LOGI(TAG, "Network is %s", online ? "online" : "offline");
+  if (_onlineCallback != nullptr)
+    _onlineCallback(online);
+}
+
 bool Mycila::ESPConnect::_durationPassed(uint32_t intervalSec, bool reset) {
   if (_lastTime >= 0 && millis() - static_cast<uint32_t>(_lastTime) >= intervalSec * 1000) {
     if (reset) {
@@ -357,5 +728,5 @@ bool Mycila::ESPConnect::_durationPassed(uint32_t intervalSec, bool reset) {
 }
 
 bool Mycila::ESPConnect::_connectionTimeout() {
-  return _state == Mycila::ESPConnect::State::NETWORK_CONNECTING && _durationPassed(_connectTimeout, false);
+  return _state == Mycila::ESPConnect::State::NETWORK_CONNECTING && _durationPassed(getEffectiveConnectTimeout(), false);
 }
@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) Mathieu Carbou
+ */
+#ifdef ESPCONNECT_METRICS
+  #include "MycilaESPConnect.h"
+  #include "MycilaESPConnect_Includes.h"
+  #include "MycilaESPConnect_Logging.h"
+
+  #include <cinttypes>
+  #include <cstdarg>
+  #include <cstdio>
+
+static const int8_t RSSIBounds[] = {-90, -80, -70, -60, -50};
+
+namespace {
+  // Appends formatted text to a fixed buffer without any heap allocation
+  class MetricsWriter {
+    public:
+      MetricsWriter(char* buffer, size_t size) : _buffer(buffer), _size(size) {}
+
+      void printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+        if (_overflow)
+          return;
+        va_list args;
+        va_start(args, format);
+        const int n = vsnprintf(_buffer + _length, _size - _length, format, args);
+        va_end(args);
+        if (n < 0 || static_cast<size_t>(n) >= _size - _length)
+          _overflow = true;
+        else
+          _length += n;
+      }
+
+      // prints a millisecond duration as seconds without relying on %llu support
+      void seconds(uint64_t ms) {
+        printf("%" PRIu32 ".%03" PRIu32 "\n", static_cast<uint32_t>(ms / 1000), static_cast<uint32_t>(ms % 1000));
+      }
+
+      size_t length() const { return _overflow ? 0 : _length; }
+
+    private:
+      char* _buffer;
+      size_t _size;
+      size_t _length = 0;
+      bool _overflow = false;
+  };
+} // namespace
+
+void Mycila::ESPConnect::_countDisconnect(uint16_t reason) {
+  for (size_t i = 0; i < ESPCONNECT_METRICS_REASONS; i++) {
+    DisconnectCounter& counter = _metrics.disconnects[i];
+    if (counter.count && counter.reason == reason) {
+      counter.count++;
+      return;
+    }
+    // first free slot: keep the last one for the reasons that do not fit
+    if (!counter.count && i < ESPCONNECT_METRICS_REASONS - 1) {
+      counter.reason = reason;
+      counter.count = 1;
+      return;
+    }
+  }
+  DisconnectCounter& other = _metrics.disconnects[ESPCONNECT_METRICS_REASONS - 1];
+  other.reason = 0;
+  other.count++;
+}
+
+void Mycila::ESPConnect::_sampleRSSI() {
+  if (getMode() != Mycila::ESPConnect::Mode::STA)
+    return;
+  if (_rssiSampledAt && millis() - _rssiSampledAt < ESPCONNECT_METRICS_RSSI_INTERVAL * 1000)
+    return;
+  _rssiSampledAt = millis();
+  const int8_t rssi = WiFi.RSSI();
+  size_t bucket = 0;
+  while (bucket < sizeof(RSSIBounds) && rssi > RSSIBounds[bucket])
+    bucket++;
+  _metrics.rssiBuckets[bucket]++;
+}
+
+size_t Mycila::ESPConnect::metricsToOpenMetrics(char* buffer, size_t size) const {
+  MetricsWriter out(buffer, size);
+  const uint32_t now = millis();
+
+  out.printf("# TYPE espconnect_state gauge\n# HELP espconnect_state Current network state\n");
+  out.printf("espconnect_state{state=\"%s\"} 1\n", getStateName());
+
+  out.printf("# TYPE espconnect_state_seconds counter\n# HELP espconnect_state_seconds Time spent in each network state\n");
+  for (size_t i = 0; i < STATE_COUNT; i++) {
+  #ifdef ESPCONNECT_NO_CAPTIVE_PORTAL
+    // values of the portal states, unused
+    if (i > static_cast<size_t>(Mycila::ESPConnect::State::AP_STARTED) && i < static_cast<size_t>(Mycila::ESPConnect::State::NETWORK_READY))
+      continue;
+  #endif
+    uint64_t ms = _metrics.stateTime[i];
+    if (i == static_cast<size_t>(_state))
+      ms += now - _metrics.stateSince;
+    out.printf("espconnect_state_seconds_total{state=\"%s\"} ", getStateName(static_cast<Mycila::ESPConnect::State>(i)));
+    out.seconds(ms);
+  }
+
+  out.printf("# TYPE espconnect_reconnects counter\n# HELP espconnect_reconnects Reconnection attempts\n");
+  out.printf("espconnect_reconnects_total %" PRIu32 "\n", _metrics.reconnects);
+
+  out.printf("# TYPE espconnect_disconnects counter\n# HELP espconnect_disconnects WiFi disconnections by reason code\n");
+  for (size_t i = 0; i < ESPCONNECT_METRICS_REASONS; i++) {
+    if (_metrics.disconnects[i].count)
+      out.printf("espconnect_disconnects_total{reason=\"%" PRIu16 "\"} %" PRIu32 "\n", _metrics.disconnects[i].reason, _metrics.disconnects[i].count);
+  }
+
+  out.printf("# TYPE espconnect_portal_sessions counter\n# HELP espconnect_portal_sessions Captive portal sessions\n");
+  out.printf("espconnect_portal_sessions_total %" PRIu32 "\n", _metrics.portalSessions);
+
+  out.printf("# TYPE espconnect_scans counter\n# HELP espconnect_scans WiFi scans\n");
+  out.printf("espconnect_scans_total %" PRIu32 "\n", _metrics.scans);
+
+  out.printf("# TYPE espconnect_scan_seconds counter\n# HELP espconnect_scan_seconds Time spent scanning WiFi networks\n");
+  out.printf("espconnect_scan_seconds_total ");
+  out.seconds(_metrics.scanTime);
+
+  out.printf("# TYPE espconnect_credential_tests counter\n# HELP espconnect_credential_tests Captive portal WiFi credential tests by result\n");
+  out.printf("espconnect_credential_tests_total{result=\"passed\"} %" PRIu32 "\n", _metrics.credentialTestsPassed);
+  out.printf("espconnect_credential_tests_total{result=\"failed\"} %" PRIu32 "\n", _metrics.credentialTestsFailed);
+
+  out.printf("# TYPE espconnect_failovers counter\n# HELP espconnect_failovers Switches of the default interface between Ethernet and WiFi\n");
+  out.printf("espconnect_failovers_total %" PRIu32 "\n", _metrics.failovers);
+
+  #ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
+  out.printf("# TYPE espconnect_https_rejected counter\n# HELP espconnect_https_rejected HTTPS connections reset while the captive portal is active\n");
+  out.printf("espconnect_https_rejected_total %" PRIu32 "\n", _metrics.httpsRejected);
+  out.printf("# TYPE espconnect_https_throttled counter\n# HELP espconnect_https_throttled Pauses of the HTTPS rejection listener by the rate limit\n");
+  out.printf("espconnect_https_throttled_total %" PRIu32 "\n", _metrics.httpsThrottled);
+
+  out.printf("# TYPE espconnect_portal_requests counter\n# HELP espconnect_portal_requests Captive portal requests by admission result\n");
+  out.printf("espconnect_portal_requests_total{result=\"admitted\"} %" PRIu32 "\n", _admissionStats.admitted);
+  out.printf("espconnect_portal_requests_total{result=\"throttled\"} %" PRIu32 "\n", _admissionStats.throttled);
+  out.printf("espconnect_portal_requests_total{result=\"busy\"} %" PRIu32 "\n", _admissionStats.busy);
+  #endif
+
+  #ifdef ESPCONNECT_WATCHDOG
+  out.printf("# TYPE espconnect_escalations counter\n# HELP espconnect_escalations Watchdog escalations by action, persisted across restarts\n");
+  for (size_t i = 0; i < ESCALATION_COUNT; i++)
+    out.printf("espconnect_escalations_total{action=\"%s\"} %" PRIu32 "\n", getEscalationName(static_cast<Mycila::ESPConnect::Escalation>(i)), _escalations[i]);
+  out.printf("# TYPE espconnect_recovery_seconds summary\n# HELP espconnect_recovery_seconds Time from the loss of the network until it is up again\n");
+  out.printf("espconnect_recovery_seconds_count %" PRIu32 "\n", _recoveries);
+  out.printf("espconnect_recovery_seconds_sum ");
+  out.seconds(_recoveryTime);
+  #endif
+
+  out.printf("# TYPE espconnect_wifi_rssi_dbm histogram\n# HELP espconnect_wifi_rssi_dbm WiFi RSSI samples\n");
+  uint32_t cumulative = 0;
+  for (size_t i = 0; i < sizeof(RSSIBounds); i++) {
+    cumulative += _metrics.rssiBuckets[i];
+    out.printf("espconnect_wifi_rssi_dbm_bucket{le=\"%" PRId8 ".0\"} %" PRIu32 "\n", RSSIBounds[i], cumulative);
+  }
+  cumulative += _metrics.rssiBuckets[sizeof(RSSIBounds)];
+  out.printf("espconnect_wifi_rssi_dbm_bucket{le=\"+Inf\"} %" PRIu32 "\n", cumulative);
+  // no _sum: OpenMetrics forbids it for a histogram with negative buckets
+  out.printf("espconnect_wifi_rssi_dbm_count %" PRIu32 "\n", cumulative);
+
+  out.printf("# EOF\n");
+
+  if (!out.length()) {
+    LOGW(TAG, "Metrics buffer too small: increase ESPCONNECT_METRICS_BUFFER_SIZE");
+  }
+  return out.length();
+}
+
+  #ifndef ESPCONNECT_NO_CAPTIVE_PORTAL
+void Mycila::ESPConnect::enableMetricsEndpoint(const char* path) {
+  if (_metricsHandler != nullptr || _httpd == nullptr)
+    return;
+
+  _metricsHandler = &_httpd->on(path, HTTP_GET, [this](AsyncWebServerRequest* request) {
+    // the buffer is sent without copy: only one scrape can be served at a time
+    if (_metricsBusy) {
+      AsyncWebServerResponse* response = request->beginResponse(503);
+      response->addHeader("Retry-After", "1");
+      request->send(response);
+      return;
+    }
+
+    const size_t length = metricsToOpenMetrics(_metricsBuffer, sizeof(_metricsBuffer));
+    if (!length) {
+      request->send(500);
+      return;
+    }
+
+    _metricsBusy = true;
+    request->onDisconnect([this]() { _metricsBusy = false; });
+    request->send(200, "application/openmetrics-text; version=1.0.0; charset=utf-8", reinterpret_cast<const uint8_t*>(_metricsBuffer), length);
+  });
+}
+
+void Mycila::ESPConnect::disableMetricsEndpoint() {
+  if (_metricsHandler == nullptr)
+    return;
+  _httpd->removeHandler(_metricsHandler);
+  _metricsHandler = nullptr;
+}
+  #endif
+
+#endif
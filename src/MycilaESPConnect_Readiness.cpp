@@ -0,0 +1,315 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) Mathieu Carbou
+ */
+#ifndef ESP8266
+  #include "MycilaESPConnect.h"
+  #include "MycilaESPConnect_Includes.h"
+  #include "MycilaESPConnect_Logging.h"
+
+  #include <esp_netif.h>
+  #include <esp_netif_net_stack.h>
+  #include <lwip/dns.h>
+  #include <lwip/etharp.h>
+  #include <lwip/sockets.h>
+  #include <lwip/tcpip.h>
+
+  #include <cstdio>
+  #include <cstdlib>
+  #include <cstring>
+  #include <ctime>
+
+  // 2024-01-01: an earlier system time was not set by SNTP
+  #define ESPCONNECT_READINESS_MIN_TIME 1704067200
+
+  // interval between the ARP requests sent to the gateway
+  #define ESPCONNECT_READINESS_ARP_INTERVAL 200
+
+void Mycila::ESPConnect::setReadinessChecks(uint8_t checks, const char* dnsName, const char* httpURL, uint32_t timeout) {
+  _stopReadiness();
+  _readinessChecks = checks;
+  _readinessTimeout = timeout;
+  _readinessDNSName = dnsName == nullptr ? "" : dnsName;
+  _readinessHTTPHost[0] = '\0';
+  _readinessHTTPPath[0] = '\0';
+  _readinessHTTPPort = 80;
+  _readiness = {};
+  _readinessRun.finishedAt = 0;
+
+  // http://host[:port][/path]
+  if (httpURL != nullptr && strncmp(httpURL, "http://", 7) == 0) {
+    const char* host = httpURL + 7;
+    const size_t hostLength = strcspn(host, ":/");
+    if (hostLength && hostLength < sizeof(_readinessHTTPHost)) {
+      memcpy(_readinessHTTPHost, host, hostLength);
+      _readinessHTTPHost[hostLength] = '\0';
+      const char* path = host + hostLength;
+      if (*path == ':') {
+        _readinessHTTPPort = static_cast<uint16_t>(atoi(path + 1));
+        path = strchr(path, '/');
+      }
+      snprintf(_readinessHTTPPath, sizeof(_readinessHTTPPath), "%s", path == nullptr || !*path ? "/" : path);
+    }
+  }
+
+  if ((checks & READY_HTTP) && (!_readinessHTTPHost[0] || !_readinessHTTPPort)) {
+    LOGE(TAG, "Readiness: invalid HTTP URL: %s", httpURL == nullptr ? "" : httpURL);
+  }
+}
+
+void Mycila::ESPConnect::_lookup(DNSLookup* lookup) {
+  // the query carries its generation: the answer of a previous run can arrive after a new lookup started
+  DNSQuery* query = new DNSQuery{lookup, lookup->generation + 1};
+  lookup->generation = query->generation;
+  // dns_gethostbyname() must be called from the TCP/IP thread, where the answers are also written
+  const err_t posted = tcpip_callback([](void* ctx) {
+    DNSQuery* query = static_cast<DNSQuery*>(ctx);
+    ip_addr_t addr;
+    const err_t err = dns_gethostbyname_addrtype(query->lookup->name, &addr, [](__unused const char* name, const ip_addr_t* addr, void* ctx) {
+      DNSQuery* query = static_cast<DNSQuery*>(ctx);
+      DNSLookup* lookup = query->lookup;
+      if (query->generation == lookup->generation) {
+        if (addr != nullptr)
+          lookup->addr = ip4_addr_get_u32(ip_2_ip4(addr));
+        lookup->result = addr != nullptr ? 1 : 0;
+        lookup->answered = query->generation;
+      }
+      delete query; }, query, LWIP_DNS_ADDRTYPE_IPV4);
+    if (err == ERR_INPROGRESS)
+      return;
+    // cached or literal address, or error: the callback is not called
+    DNSLookup* lookup = query->lookup;
+    if (query->generation == lookup->generation) {
+      if (err == ERR_OK)
+        lookup->addr = ip4_addr_get_u32(ip_2_ip4(&addr));
+      lookup->result = err == ERR_OK ? 1 : 0;
+      lookup->answered = query->generation;
+    }
+    delete query; }, query);
+  // stays pending until the readiness timeout
+  if (posted != ERR_OK)
+    delete query;
+}
+
+void Mycila::ESPConnect::_startReadiness(uint32_t now) {
+  ReadinessRun& run = _readinessRun;
+  if (!run.finishedAt)
+    run.connectedAt = now;
+  run.pending = _readinessChecks;
+  run.startedAt = now;
+  run.socket = -1;
+  _readiness.passed = 0;
+  memset(_readiness.latency, 0, sizeof(_readiness.latency));
+
+  if (run.pending & READY_GATEWAY) {
+  #ifdef ESPCONNECT_ETH_SUPPORT
+    esp_netif_t* netif = _computeMode() == Mycila::ESPConnect::Mode::ETH ? ETH.netif() : WiFi.STA.netif();
+    run.gateway = static_cast<uint32_t>(_computeMode() == Mycila::ESPConnect::Mode::ETH ? ETH.gatewayIP() : WiFi.STA.gatewayIP());
+  #else
+    esp_netif_t* netif = WiFi.STA.netif();
+    run.gateway = static_cast<uint32_t>(WiFi.STA.gatewayIP());
+  #endif
+    run.netif = netif == nullptr ? nullptr : esp_netif_get_netif_impl(netif);
+    run.gatewayFound = 0;
+    // sends the first request on the next loop()
+    run.gatewayQueryAt = now - ESPCONNECT_READINESS_ARP_INTERVAL;
+    if (run.netif == nullptr || !run.gateway)
+      _readinessFailed(READY_GATEWAY);
+  }
+
+  if (run.pending & READY_DNS) {
+    if (_readinessDNSName.length()) {
+      run.dns.name = _readinessDNSName.c_str();
+      _lookup(&run.dns);
+    } else {
+      _readinessFailed(READY_DNS);
+    }
+  }
+
+  if (run.pending & READY_HTTP) {
+    run.httpStep = 0;
+    run.statusLength = 0;
+    if (_readinessHTTPHost[0] && _readinessHTTPPort) {
+      run.httpHost.name = _readinessHTTPHost;
+      _lookup(&run.httpHost);
+    } else {
+      _readinessFailed(READY_HTTP);
+    }
+  }
+}
+
+void Mycila::ESPConnect::_stopReadiness() {
+  if ((_readinessRun.pending & READY_HTTP) && _readinessRun.socket >= 0)
+    close(_readinessRun.socket);
+  _readinessRun.socket = -1;
+  _readinessRun.pending = 0;
+}
+
+void Mycila::ESPConnect::_readinessPassed(uint8_t check, uint32_t now) {
+  _readinessRun.pending &= ~check;
+  _readiness.passed |= check;
+  _readiness.latency[__builtin_ctz(check)] = now - _readinessRun.startedAt;
+}
+
+void Mycila::ESPConnect::_readinessFailed(uint8_t check) {
+  if (check == READY_HTTP && _readinessRun.socket >= 0) {
+    close(_readinessRun.socket);
+    _readinessRun.socket = -1;
+  }
+  _readinessRun.pending &= ~check;
+}
+
+void Mycila::ESPConnect::_pollHTTP(uint32_t now) {
+  ReadinessRun& run = _readinessRun;
+
+  switch (run.httpStep) {
+    case 0: {
+      const int8_t result = _lookupResult(run.httpHost);
+      if (result < 0)
+        return;
+      if (result == 0) {
+        _readinessFailed(READY_HTTP);
+        return;
+      }
+      struct sockaddr_in addr = {};
+      addr.sin_family = AF_INET;
+      addr.sin_port = htons(_readinessHTTPPort);
+      addr.sin_addr.s_addr = run.httpHost.addr;
+      run.socket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+      if (run.socket < 0) {
+        _readinessFailed(READY_HTTP);
+        return;
+      }
+      fcntl(run.socket, F_SETFL, fcntl(run.socket, F_GETFL, 0) | O_NONBLOCK);
+      if (connect(run.socket, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0 && errno != EINPROGRESS) {
+        _readinessFailed(READY_HTTP);
+        return;
+      }
+      run.httpStep = 1;
+      return;
+    }
+
+    case 1: {
+      fd_set writable;
+      FD_ZERO(&writable);
+      FD_SET(run.socket, &writable);
+      struct timeval timeout = {0, 0};
+      if (select(run.socket + 1, nullptr, &writable, nullptr, &timeout) <= 0)
+        return;
+      int error = 0;
+      socklen_t length = sizeof(error);
+      getsockopt(run.socket, SOL_SOCKET, SO_ERROR, &error, &length);
+      char request[256];
+      const int size = snprintf(request, sizeof(request), "GET %s HTTP/1.0\r\nHost: %s\r\nConnection: close\r\n\r\n", _readinessHTTPPath, _readinessHTTPHost);
+      if (error || size >= static_cast<int>(sizeof(request)) || send(run.socket, request, size, 0) != size) {
+        _readinessFailed(READY_HTTP);
+        return;
+      }
+      run.httpStep = 2;
+      return;
+    }
+
+    default: {
+      // status line: HTTP/1.x NNN
+      const ssize_t n = recv(run.socket, run.status + run.statusLength, sizeof(run.status) - 1 - run.statusLength, 0);
+      if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        return;
+      if (n <= 0) {
+        _readinessFailed(READY_HTTP);
+        return;
+      }
+      run.statusLength += n;
+      if (run.statusLength < sizeof(run.status) - 1)
+        return;
+      run.status[run.statusLength] = '\0';
+      // a redirect is usually a captive portal
+      if (strncmp(run.status, "HTTP/1.", 7) == 0 && run.status[9] == '2') {
+        close(run.socket);
+        run.socket = -1;
+        _readinessPassed(READY_HTTP, now);
+      } else {
+        LOGD(TAG, "Readiness: HTTP status: %s", run.status + 9);
+        _readinessFailed(READY_HTTP);
+      }
+      return;
+    }
+  }
+}
+
+void Mycila::ESPConnect::_readinessLoop() {
+  if (!_readinessChecks)
+    return;
+
+  ReadinessRun& run = _readinessRun;
+
+  if (_state != Mycila::ESPConnect::State::NETWORK_CONNECTED) {
+    _stopReadiness();
+    if (_state != Mycila::ESPConnect::State::NETWORK_READY) {
+      run.finishedAt = 0;
+      _readiness.total = 0;
+    }
+    return;
+  }
+
+  const uint32_t now = millis();
+
+  if (!run.pending) {
+    if (run.finishedAt && now - run.finishedAt < ESPCONNECT_READINESS_RETRY)
+      return;
+    _startReadiness(now);
+  }
+
+  if (run.pending & READY_GATEWAY) {
+    if (run.gatewayFound) {
+      _readinessPassed(READY_GATEWAY, now);
+    } else if (now - run.gatewayQueryAt >= ESPCONNECT_READINESS_ARP_INTERVAL) {
+      run.gatewayQueryAt = now;
+      // a reply makes the entry of the ARP cache stable, otherwise the request is sent again
+      tcpip_callback([](void* ctx) {
+        ReadinessRun* run = static_cast<ReadinessRun*>(ctx);
+        ip4_addr_t ip;
+        ip4_addr_set_u32(&ip, run->gateway);
+        struct eth_addr* eth;
+        const ip4_addr_t* found;
+        if (etharp_find_addr(static_cast<struct netif*>(run->netif), &ip, &eth, &found) >= 0)
+          run->gatewayFound = 1;
+        else
+          etharp_query(static_cast<struct netif*>(run->netif), &ip, nullptr); }, &run);
+    }
+  }
+
+  if ((run.pending & READY_DNS) && _lookupResult(run.dns) >= 0) {
+    if (_lookupResult(run.dns))
+      _readinessPassed(READY_DNS, now);
+    else
+      _readinessFailed(READY_DNS);
+  }
+
+  if ((run.pending & READY_SNTP) && time(nullptr) >= ESPCONNECT_READINESS_MIN_TIME)
+    _readinessPassed(READY_SNTP, now);
+
+  if (run.pending & READY_HTTP)
+    _pollHTTP(now);
+
+  if (run.pending && now - run.startedAt >= _readinessTimeout) {
+    if (run.pending & READY_HTTP)
+      _readinessFailed(READY_HTTP);
+    run.pending = 0;
+  }
+
+  if (run.pending)
+    return;
+
+  run.finishedAt = now;
+
+  if (_readiness.passed != _readinessChecks) {
+    LOGW(TAG, "Readiness checks failed: 0x%02" PRIx8 ", retrying in %d ms", static_cast<uint8_t>(_readinessChecks & ~_readiness.passed), ESPCONNECT_READINESS_RETRY);
+    return;
+  }
+
+  _readiness.total = now - run.connectedAt;
+  LOGI(TAG, "Network ready in %" PRIu32 " ms (gateway: %" PRIu32 " ms, DNS: %" PRIu32 " ms, SNTP: %" PRIu32 " ms, HTTP: %" PRIu32 " ms)", _readiness.total, _readiness.latency[0], _readiness.latency[1], _readiness.latency[2], _readiness.latency[3]);
+  _setState(Mycila::ESPConnect::State::NETWORK_READY);
+}
+
+#endif
@@ -5,16 +5,37 @@
 #include "MycilaESPConnect.h"
 #include "MycilaESPConnect_Includes.h"
 #include "MycilaESPConnect_Logging.h"
+#include "MycilaESPConnect_Trace.h"
 
 void Mycila::ESPConnect::_startSTA() {
   LOGI(TAG, "Starting WiFi...");
-  _setState(Mycila::ESPConnect::State::NETWORK_CONNECTING);
+  // Ethernet is up when only WiFi is restarted by the watchdog
+  if (!_isNetworkUp())
+    _setState(Mycila::ESPConnect::State::NETWORK_CONNECTING);
+#ifdef ESPCONNECT_ETH_SUPPORT
+  _staStartedAt = millis();
+  _staTimeToIP = 0;
+#endif
+
+#ifdef ESPCONNECT_ADAPTIVE_TIMEOUT
+  _loadTimeToIP();
+#endif
+
+#ifdef ESPCONNECT_DUTY_CYCLE
+  // woken up from deep sleep: channel, BSSID and DHCP lease retained in RTC memory
+  if (_startSTAFast())
+    return;
+#endif
 
+  TRACE_BEGIN(TRACE_TRACK_WIFI, "radio_off");
   WiFi.disconnect(true);
   WiFi.mode(WIFI_MODE_NULL);
+  TRACE_END("radio_off");
 
 #ifndef ESP8266
-  WiFi.setScanMethod(WIFI_ALL_CHANNEL_SCAN);
+  // the AP is probably still on the channel of the last connection: the fast scan starts there and stops at the first AP found
+  const uint8_t channel = _scanOptions.channelHint && !_config.wifiBSSID.length() && _channelHintSSID == _config.wifiSSID ? _channelHint : 0;
+  WiFi.setScanMethod(channel ? WIFI_FAST_SCAN : WIFI_ALL_CHANNEL_SCAN);
   WiFi.setSortMethod(WIFI_CONNECT_AP_BY_SIGNAL);
 #endif
 
@@ -23,22 +44,22 @@ void Mycila::ESPConnect::_startSTA() {
   WiFi.persistent(false);
   WiFi.setAutoReconnect(true);
 
+  TRACE_BEGIN(TRACE_TRACK_WIFI, "radio_init");
+#ifdef ESPCONNECT_DUTY_CYCLE
+  if (!_radioOnAt)
+    _radioOnAt = millis();
+#endif
   WiFi.mode(WIFI_MODE_STA);
+  TRACE_END("radio_init");
 #ifndef ESP8266
   WiFi.enableIPv6();
 #endif
 
-#ifndef ESPCONNECT_ETH_SUPPORT
-  if (_config.ipConfig.ip) {
-    LOGI(TAG, "Set WiFi Static IP Configuration:");
-    LOGI(TAG, " - IP: %s", _config.ipConfig.ip.toString().c_str());
-    LOGI(TAG, " - Gateway: %s", _config.ipConfig.gateway.toString().c_str());
-    LOGI(TAG, " - Subnet: %s", _config.ipConfig.subnet.toString().c_str());
-    LOGI(TAG, " - DNS: %s", _config.ipConfig.dns.toString().c_str());
+  // a static IP is probed once associated (ARDUINO_EVENT_WIFI_STA_CONNECTED)
+  _setIPConfig(Mycila::ESPConnect::Mode::STA, false);
 
-    WiFi.config(_config.ipConfig.ip, _config.ipConfig.gateway, _config.ipConfig.subnet, _config.ipConfig.dns);
-  }
-#endif
+  // scan, authentication, association and 4-way handshake, until ARDUINO_EVENT_WIFI_STA_CONNECTED
+  TRACE_BEGIN(TRACE_TRACK_WIFI, "association");
 
   if (_config.wifiBSSID.length()) {
     LOGI(TAG, "Connecting to SSID: %s with BSSID: %s", _config.wifiSSID.c_str(), _config.wifiBSSID.c_str());
@@ -47,6 +68,11 @@ void Mycila::ESPConnect::_startSTA() {
     bssid.fromString(_config.wifiBSSID.c_str());
 
     WiFi.begin(_config.wifiSSID.c_str(), _config.wifiPassword.c_str(), 0, bssid);
+#ifndef ESP8266
+  } else if (channel) {
+    LOGI(TAG, "Connecting to SSID: %s on channel: %" PRIu8, _config.wifiSSID.c_str(), channel);
+    WiFi.begin(_config.wifiSSID.c_str(), _config.wifiPassword.c_str(), channel);
+#endif
   } else {
     LOGI(TAG, "Connecting to SSID: %s", _config.wifiSSID.c_str());
     WiFi.begin(_config.wifiSSID.c_str(), _config.wifiPassword.c_str());
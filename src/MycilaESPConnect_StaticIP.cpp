@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) Mathieu Carbou
+ */
+#include "MycilaESPConnect.h"
+#include "MycilaESPConnect_Includes.h"
+#include "MycilaESPConnect_Logging.h"
+
+#ifndef ESP8266
+  #include <esp_netif.h>
+  #include <esp_netif_net_stack.h>
+  #include <lwip/etharp.h>
+  #include <lwip/tcpip.h>
+#endif
+
+const Mycila::ESPConnect::IPConfig* Mycila::ESPConnect::_staticIPConfig(Mycila::ESPConnect::Mode mode) const {
+#ifdef ESPCONNECT_ETH_SUPPORT
+  // without ethIPConfig, ipConfig is used for Ethernet like in previous versions and WiFi uses DHCP
+  if (!_config.ethIPConfig.ip)
+    return mode == Mycila::ESPConnect::Mode::ETH && _config.ipConfig.ip ? &_config.ipConfig : nullptr;
+  if (mode == Mycila::ESPConnect::Mode::ETH)
+    return &_config.ethIPConfig;
+#endif
+  return mode == Mycila::ESPConnect::Mode::STA && _config.ipConfig.ip ? &_config.ipConfig : nullptr;
+}
+
+void Mycila::ESPConnect::_setIPConfig(Mycila::ESPConnect::Mode mode, bool linkUp) {
+  const Mycila::ESPConnect::IPConfig* config = _staticIPConfig(mode);
+  _ipConflicts &= ~(1 << static_cast<int>(mode));
+
+  if (config != nullptr) {
+    LOGI(TAG, "Set %s Static IP Configuration:", mode == Mycila::ESPConnect::Mode::ETH ? "Ethernet" : "WiFi");
+    LOGI(TAG, " - IP: %s", config->ip.toString().c_str());
+    LOGI(TAG, " - Gateway: %s", config->gateway.toString().c_str());
+    LOGI(TAG, " - Subnet: %s", config->subnet.toString().c_str());
+    LOGI(TAG, " - DNS: %s", config->dns.toString().c_str());
+  }
+
+#ifdef ESP8266
+  (void)linkUp;
+  // zero addresses: DHCP
+  if (config != nullptr)
+    WiFi.config(config->ip, config->gateway, config->subnet, config->dns);
+  else
+    WiFi.config(IPAddress(), IPAddress(), IPAddress());
+#else
+  #ifdef ESPCONNECT_ETH_SUPPORT
+  esp_netif_t* netif = mode == Mycila::ESPConnect::Mode::ETH ? ETH.netif() : WiFi.STA.netif();
+  #else
+  esp_netif_t* netif = WiFi.STA.netif();
+  #endif
+  if (netif == nullptr)
+    return;
+
+  if (config == nullptr) {
+    _stopArpProbe(mode);
+    // does nothing if the DHCP client is already started
+    esp_netif_dhcpc_start(netif);
+    return;
+  }
+
+  // no address until the ARP probes are done: they are sent from 0.0.0.0
+  esp_netif_dhcpc_stop(netif);
+  if (linkUp)
+    _startArpProbe(mode);
+#endif
+}
+
+void Mycila::ESPConnect::_setDNS(Mycila::ESPConnect::Mode mode) {
+  const Mycila::ESPConnect::IPConfig* config = _staticIPConfig(mode);
+  // with DHCP, the DNS server comes from the lease
+  if (config == nullptr)
+    return;
+  LOGI(TAG, "Set %s DNS: %s", mode == Mycila::ESPConnect::Mode::ETH ? "Ethernet" : "WiFi", config->dns.toString().c_str());
+
+#ifdef ESP8266
+  WiFi.config(config->ip, config->gateway, config->subnet, config->dns);
+#else
+  #ifdef ESPCONNECT_ETH_SUPPORT
+  esp_netif_t* netif = mode == Mycila::ESPConnect::Mode::ETH ? ETH.netif() : WiFi.STA.netif();
+  #else
+  esp_netif_t* netif = WiFi.STA.netif();
+  #endif
+  if (netif == nullptr)
+    return;
+  esp_netif_dns_info_t dns = {};
+  dns.ip.type = ESP_IPADDR_TYPE_V4;
+  dns.ip.u_addr.ip4.addr = static_cast<uint32_t>(config->dns);
+  esp_netif_set_dns_info(netif, ESP_NETIF_DNS_MAIN, &dns);
+#endif
+}
+
+#ifndef ESP8266
+void Mycila::ESPConnect::_startArpProbe(Mycila::ESPConnect::Mode mode) {
+  const Mycila::ESPConnect::IPConfig* config = _staticIPConfig(mode);
+  if (config == nullptr)
+    return;
+
+  #ifdef ESPCONNECT_ETH_SUPPORT
+  ArpProbe& probe = mode == Mycila::ESPConnect::Mode::ETH ? _ethProbe : _staProbe;
+  esp_netif_t* netif = mode == Mycila::ESPConnect::Mode::ETH ? ETH.netif() : WiFi.STA.netif();
+  #else
+  ArpProbe& probe = _staProbe;
+  esp_netif_t* netif = WiFi.STA.netif();
+  #endif
+  if (netif == nullptr || esp_netif_get_netif_impl(netif) == nullptr)
+    return;
+
+  LOGD(TAG, "Probing static IP: %s", config->ip.toString().c_str());
+  probe.netif = esp_netif_get_netif_impl(netif);
+  probe.ip = static_cast<uint32_t>(config->ip);
+  probe.sent = 0;
+  probe.result = -1;
+  probe.lastAt = millis();
+  probe.running = true;
+
+  // a stale entry of the ARP cache would be seen as a conflict
+  tcpip_callback([](void* ctx) { etharp_cleanup_netif(static_cast<struct netif*>(ctx)); }, probe.netif);
+}
+
+void Mycila::ESPConnect::_stopArpProbe(Mycila::ESPConnect::Mode mode) {
+  #ifdef ESPCONNECT_ETH_SUPPORT
+  (mode == Mycila::ESPConnect::Mode::ETH ? _ethProbe : _staProbe).running = false;
+  #else
+  (void)mode;
+  _staProbe.running = false;
+  #endif
+}
+
+void Mycila::ESPConnect::_arpProbeLoop(Mycila::ESPConnect::Mode mode) {
+  #ifdef ESPCONNECT_ETH_SUPPORT
+  ArpProbe& probe = mode == Mycila::ESPConnect::Mode::ETH ? _ethProbe : _staProbe;
+  #else
+  ArpProbe& probe = _staProbe;
+  #endif
+  if (!probe.running)
+    return;
+
+  const uint32_t now = millis();
+
+  if (probe.sent < ESPCONNECT_ARP_PROBE_NUM) {
+    if (now - probe.lastAt < ESPCONNECT_ARP_PROBE_INTERVAL)
+      return;
+    probe.sent++;
+    probe.lastAt = now;
+    // ARP request for the address from 0.0.0.0: a reply turns the pending entry of the ARP cache into a stable one
+    tcpip_callback([](void* ctx) {
+      ArpProbe* probe = static_cast<ArpProbe*>(ctx);
+      ip4_addr_t ip;
+      ip4_addr_set_u32(&ip, probe->ip);
+      etharp_query(static_cast<struct netif*>(probe->netif), &ip, nullptr); }, &probe);
+    return;
+  }
+
+  if (probe.result < 0) {
+    if (probe.sent == ESPCONNECT_ARP_PROBE_NUM && now - probe.lastAt >= ESPCONNECT_ARP_PROBE_WAIT) {
+      probe.sent++;
+      tcpip_callback([](void* ctx) {
+        ArpProbe* probe = static_cast<ArpProbe*>(ctx);
+        ip4_addr_t ip;
+        ip4_addr_set_u32(&ip, probe->ip);
+        struct eth_addr* eth;
+        const ip4_addr_t* found;
+        probe->result = etharp_find_addr(static_cast<struct netif*>(probe->netif), &ip, &eth, &found) >= 0 ? 1 : 0; }, &probe);
+    }
+    return;
+  }
+
+  probe.running = false;
+
+  const Mycila::ESPConnect::IPConfig* config = _staticIPConfig(mode);
+  if (config == nullptr)
+    return;
+
+  if (probe.result == 0) {
+    LOGI(TAG, "Static IP %s is free", config->ip.toString().c_str());
+  #ifdef ESPCONNECT_ETH_SUPPORT
+    if (mode == Mycila::ESPConnect::Mode::ETH) {
+      ETH.config(config->ip, config->gateway, config->subnet, config->dns);
+      return;
+    }
+  #endif
+    WiFi.config(config->ip, config->gateway, config->subnet, config->dns);
+    return;
+  }
+
+  LOGW(TAG, "Static IP %s is used by another host: falling back to DHCP", config->ip.toString().c_str());
+  _ipConflicts |= 1 << static_cast<int>(mode);
+  #ifdef ESPCONNECT_ETH_SUPPORT
+  esp_netif_dhcpc_start(mode == Mycila::ESPConnect::Mode::ETH ? ETH.netif() : WiFi.STA.netif());
+  #else
+  esp_netif_dhcpc_start(WiFi.STA.netif());
+  #endif
+}
+#endif
@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) Mathieu Carbou
+ */
+#ifdef ESPCONNECT_ADAPTIVE_TIMEOUT
+  #include "MycilaESPConnect.h"
+  #include "MycilaESPConnect_Includes.h"
+  #include "MycilaESPConnect_Logging.h"
+
+  #include <cinttypes>
+  #include <cstdio>
+  #include <cstring>
+
+// upper bound in ms of each bucket of the time-to-IP histogram, the last one is unbounded
+static const uint32_t TimeToIPBounds[ESPCONNECT_TIME_TO_IP_BUCKETS - 1] = {500, 1000, 1500, 2000, 3000, 4000, 5000, 7500, 10000, 15000, 20000, 30000, 45000, 60000, 90000};
+
+// FNV-1a: the SSID can be longer than the 15 characters allowed for a NVS key
+static uint32_t _networkHash(const char* ssid) {
+  uint32_t hash = 2166136261UL;
+  while (*ssid) {
+    hash ^= static_cast<uint8_t>(*ssid++);
+    hash *= 16777619UL;
+  }
+  // 0 means "not loaded"
+  return hash ? hash : 1;
+}
+
+static void _networkKey(char* key, size_t size, uint32_t hash) {
+  snprintf(key, size, "n%08" PRIx32, hash);
+}
+
+void Mycila::ESPConnect::_loadTimeToIP() {
+  const uint32_t network = _networkHash(_config.wifiSSID.c_str());
+  if (network == _timeToIPNetwork)
+    return;
+
+  // keep the samples of the previous network
+  if (_timeToIPUnsaved)
+    _saveTimeToIP();
+
+  _timeToIPNetwork = network;
+  _adaptiveMiss = false;
+  memset(_timeToIP, 0, sizeof(_timeToIP));
+
+  char key[12];
+  _networkKey(key, sizeof(key), network);
+  Preferences preferences;
+  preferences.begin("espconnect-tti", true);
+  if (preferences.isKey(key))
+    preferences.getBytes(key, _timeToIP, sizeof(_timeToIP));
+  preferences.end();
+
+  LOGD(TAG, "Learned time-to-IP of %s: %" PRIu32 " ms", _config.wifiSSID.c_str(), getLearnedTimeToIP());
+}
+
+void Mycila::ESPConnect::_saveTimeToIP() {
+  char key[12];
+  _networkKey(key, sizeof(key), _timeToIPNetwork);
+  Preferences preferences;
+  preferences.begin("espconnect-tti", false);
+  preferences.putBytes(key, _timeToIP, sizeof(_timeToIP));
+  preferences.end();
+  _timeToIPUnsaved = 0;
+}
+
+void Mycila::ESPConnect::_recordTimeToIP(uint32_t ms) {
+  _loadTimeToIP();
+  _adaptiveMiss = false;
+  const uint32_t learned = getLearnedTimeToIP();
+
+  size_t bucket = 0;
+  while (bucket < ESPCONNECT_TIME_TO_IP_BUCKETS - 1 && ms > TimeToIPBounds[bucket])
+    bucket++;
+  _timeToIP[bucket]++;
+
+  uint32_t total = 0;
+  for (size_t i = 0; i < ESPCONNECT_TIME_TO_IP_BUCKETS; i++)
+    total += _timeToIP[i];
+  if (total >= ESPCONNECT_ADAPTIVE_TIMEOUT_WINDOW) {
+    for (size_t i = 0; i < ESPCONNECT_TIME_TO_IP_BUCKETS; i++)
+      _timeToIP[i] /= 2;
+  }
+
+  // the flash is only written when the learned time-to-IP changes, or every few samples (i.e. once per wake in duty cycle mode otherwise)
+  if (getLearnedTimeToIP() != learned || ++_timeToIPUnsaved >= ESPCONNECT_ADAPTIVE_TIMEOUT_SAVE_EVERY)
+    _saveTimeToIP();
+
+  LOGD(TAG, "Time-to-IP: %" PRIu32 " ms, next connection timeout: %" PRIu32 " s", ms, getEffectiveConnectTimeout());
+}
+
+uint32_t Mycila::ESPConnect::getLearnedTimeToIP() const {
+  uint32_t total = 0;
+  for (size_t i = 0; i < ESPCONNECT_TIME_TO_IP_BUCKETS; i++)
+    total += _timeToIP[i];
+  if (total < ESPCONNECT_ADAPTIVE_TIMEOUT_MIN_SAMPLES)
+    return 0;
+
+  // rank of the sample at the percentile, rounded up
+  const uint32_t rank = (total * _adaptivePercentile + 99) / 100;
+  uint32_t cumulative = 0;
+  for (size_t i = 0; i < ESPCONNECT_TIME_TO_IP_BUCKETS - 1; i++) {
+    cumulative += _timeToIP[i];
+    if (cumulative >= rank)
+      return TimeToIPBounds[i];
+  }
+  return _adaptiveMaxTimeout * 1000;
+}
+
+uint32_t Mycila::ESPConnect::getEffectiveConnectTimeout() const {
+  const uint32_t learned = getLearnedTimeToIP();
+  if (!learned)
+    return _connectTimeout;
+  // the learned timeout was too short on the last attempt (i.e. slow DHCP server): give the network more time
+  if (_adaptiveMiss)
+    return _adaptiveMaxTimeout;
+  const uint32_t timeout = static_cast<uint32_t>(learned * _adaptiveFactor + 999) / 1000;
+  return timeout < _adaptiveMinTimeout ? _adaptiveMinTimeout : (timeout > _adaptiveMaxTimeout ? _adaptiveMaxTimeout : timeout);
+}
+
+void Mycila::ESPConnect::clearTimeToIP() {
+  Preferences preferences;
+  preferences.begin("espconnect-tti", false);
+  preferences.clear();
+  preferences.end();
+  memset(_timeToIP, 0, sizeof(_timeToIP));
+  _timeToIPUnsaved = 0;
+  _timeToIPSample = 0;
+  _adaptiveMiss = false;
+}
+
+#endif
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) Mathieu Carbou
+ */
+#ifdef ESPCONNECT_TRACE
+  #include "MycilaESPConnect.h"
+  #include "MycilaESPConnect_Includes.h"
+  #include "MycilaESPConnect_Logging.h"
+  #include "MycilaESPConnect_Trace.h"
+
+  #include <cinttypes>
+  #include <cstring>
+
+  #define TRACE_XSTR(x) #x
+  #define TRACE_STR(x)  TRACE_XSTR(x)
+
+  #ifndef ESP8266
+    #include <esp_timer.h>
+    #define TRACE_LOCK()   portENTER_CRITICAL(&_traceLock)
+    #define TRACE_UNLOCK() portEXIT_CRITICAL(&_traceLock)
+  #else
+    #define TRACE_LOCK()
+    #define TRACE_UNLOCK()
+  #endif
+
+static int64_t _traceNow() {
+  #ifdef ESP8266
+  return static_cast<int64_t>(micros64());
+  #else
+  return esp_timer_get_time();
+  #endif
+}
+
+// prints a 64-bit microsecond timestamp without relying on %lld support
+static void _tracePrintUs(Print& out, int64_t us) {
+  const uint32_t sec = static_cast<uint32_t>(us / 1000000);
+  const uint32_t rem = static_cast<uint32_t>(us % 1000000);
+  if (sec)
+    out.printf("%" PRIu32 "%06" PRIu32, sec, rem);
+  else
+    out.printf("%" PRIu32, rem);
+}
+
+void Mycila::ESPConnect::_traceBegin(const char* name, uint8_t track) {
+  const int64_t now = _traceNow();
+  TRACE_LOCK();
+  TraceSpan& span = _traceSpans[_traceHead];
+  span.name = name;
+  span.track = track;
+  span.start = now;
+  span.end = -1;
+  _traceHead = (_traceHead + 1) % ESPCONNECT_TRACE_SIZE;
+  if (_traceCount < ESPCONNECT_TRACE_SIZE)
+    _traceCount++;
+  TRACE_UNLOCK();
+}
+
+void Mycila::ESPConnect::_traceEnd(const char* name) {
+  const int64_t now = _traceNow();
+  TRACE_LOCK();
+  // close the most recent open span with this name
+  for (size_t i = 1; i <= _traceCount; i++) {
+    TraceSpan& span = _traceSpans[(_traceHead + ESPCONNECT_TRACE_SIZE - i) % ESPCONNECT_TRACE_SIZE];
+    if (span.end < 0 && strcmp(span.name, name) == 0) {
+      span.end = now;
+      break;
+    }
+  }
+  TRACE_UNLOCK();
+}
+
+void Mycila::ESPConnect::clearTrace() {
+  TRACE_LOCK();
+  _traceHead = 0;
+  _traceCount = 0;
+  TRACE_UNLOCK();
+}
+
+void Mycila::ESPConnect::traceToJson(Print& out) const {
+  // copy the ring buffer so that we do not hold the lock while printing
+  TraceSpan spans[ESPCONNECT_TRACE_SIZE];
+  TRACE_LOCK();
+  const size_t count = _traceCount;
+  for (size_t i = 0; i < count; i++)
+    spans[i] = _traceSpans[(_traceHead + ESPCONNECT_TRACE_SIZE - count + i) % ESPCONNECT_TRACE_SIZE];
+  TRACE_UNLOCK();
+
+  out.print("{\"displayTimeUnit\":\"ms\",\"otherData\":{\"version\":\"" ESPCONNECT_VERSION "\"},\"traceEvents\":[");
+  out.print("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"ESPConnect\"}},");
+  out.print("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" TRACE_STR(TRACE_TRACK_LIFECYCLE) ",\"args\":{\"name\":\"lifecycle\"}},");
+  out.print("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" TRACE_STR(TRACE_TRACK_WIFI) ",\"args\":{\"name\":\"wifi\"}},");
+  out.print("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" TRACE_STR(TRACE_TRACK_ETH) ",\"args\":{\"name\":\"eth\"}},");
+  out.print("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" TRACE_STR(TRACE_TRACK_IPV6) ",\"args\":{\"name\":\"ipv6\"}}");
+
+  for (size_t i = 0; i < count; i++) {
+    const TraceSpan& span = spans[i];
+    // completed spans are exported as complete events, open spans as begin events
+    out.printf(",{\"name\":\"%s\",\"cat\":\"espconnect\",\"ph\":\"%s\",\"pid\":1,\"tid\":%u,\"ts\":", span.name, span.end < 0 ? "B" : "X", static_cast<unsigned>(span.track));
+    _tracePrintUs(out, span.start);
+    if (span.end >= 0) {
+      out.print(",\"dur\":");
+      _tracePrintUs(out, span.end - span.start);
+    }
+    out.print("}");
+  }
+
+  out.print("]}");
+}
+
+#endif
@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) Mathieu Carbou
+ */
+#pragma once
+
+// Tracks (thread ids) used to display the spans in the trace viewer
+#define TRACE_TRACK_LIFECYCLE 1
+#define TRACE_TRACK_WIFI      2
+#define TRACE_TRACK_ETH       3
+#define TRACE_TRACK_IPV6      4
+
+#ifdef ESPCONNECT_TRACE
+  #define TRACE_BEGIN(track, name) _traceBegin(name, track)
+  #define TRACE_END(name)          _traceEnd(name)
+#else
+  #define TRACE_BEGIN(track, name)
+  #define TRACE_END(name)
+#endif
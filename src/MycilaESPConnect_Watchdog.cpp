@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) Mathieu Carbou
+ */
+#ifdef ESPCONNECT_WATCHDOG
+  #include "MycilaESPConnect.h"
+  #include "MycilaESPConnect_Includes.h"
+  #include "MycilaESPConnect_Logging.h"
+
+  #include <cinttypes>
+  #include <cstring>
+
+static const char* EscalationNames[] = {
+  "RECONNECT",
+  "RADIO_RESTART",
+  "INTERFACE_RESTART",
+  "SYSTEM_RESTART",
+};
+
+const char* Mycila::ESPConnect::getEscalationName(Mycila::ESPConnect::Escalation escalation) {
+  return EscalationNames[static_cast<size_t>(escalation)];
+}
+
+void Mycila::ESPConnect::_loadEscalations() {
+  Preferences preferences;
+  preferences.begin("espconnect-wd", false);
+  if (preferences.isKey("counters"))
+    preferences.getBytes("counters", _escalations, sizeof(_escalations));
+  // outage in progress when the watchdog restarted the ESP: the recovery time includes the restart
+  const uint32_t outage = preferences.getUInt("outage", 0);
+  if (outage) {
+    preferences.remove("outage");
+    _outage = true;
+    _outageSince = millis() - outage;
+  }
+  preferences.end();
+
+  LOGD(TAG, "Watchdog: %" PRIu32 " reconnects, %" PRIu32 " radio restarts, %" PRIu32 " interface restarts, %" PRIu32 " system restarts", _escalations[0], _escalations[1], _escalations[2], _escalations[3]);
+}
+
+void Mycila::ESPConnect::_saveEscalations(uint32_t outage) {
+  Preferences preferences;
+  preferences.begin("espconnect-wd", false);
+  preferences.putBytes("counters", _escalations, sizeof(_escalations));
+  if (outage)
+    preferences.putUInt("outage", outage);
+  preferences.end();
+}
+
+void Mycila::ESPConnect::clearEscalations() {
+  Preferences preferences;
+  preferences.begin("espconnect-wd", false);
+  preferences.clear();
+  preferences.end();
+  memset(_escalations, 0, sizeof(_escalations));
+}
+
+void Mycila::ESPConnect::_watchdogOnState(Mycila::ESPConnect::State previous, Mycila::ESPConnect::State state) {
+  const uint32_t now = millis();
+  _watchdogSince = now;
+
+  if (state == Mycila::ESPConnect::State::NETWORK_DISABLED) {
+    _outage = false;
+    _escalationLevel = 0;
+    return;
+  }
+
+  if (_isNetworkUp()) {
+    if (_outage) {
+      _outage = false;
+      _recoveries++;
+      _recoveryTime += now - _outageSince;
+      LOGI(TAG, "Watchdog: network recovered in %" PRIu32 " ms", now - _outageSince);
+    }
+    _escalationLevel = 0;
+    return;
+  }
+
+  if (!_outage && (previous == Mycila::ESPConnect::State::NETWORK_CONNECTED || previous == Mycila::ESPConnect::State::NETWORK_READY)) {
+    _outage = true;
+    _outageSince = now;
+  }
+}
+
+void Mycila::ESPConnect::_watchdogLoop() {
+  const uint32_t limit = _dwellLimits[static_cast<size_t>(_state)];
+  if (!limit)
+    return;
+  if (millis() - _watchdogSince >= limit)
+    _escalate();
+}
+
+void Mycila::ESPConnect::_escalate() {
+  const uint32_t now = millis();
+
+  // the last step is taken again until it works
+  Mycila::ESPConnect::Escalation escalation = static_cast<Mycila::ESPConnect::Escalation>(_escalationLevel < ESCALATION_COUNT ? _escalationLevel : ESCALATION_COUNT - 1);
+  #ifndef ESPCONNECT_ETH_SUPPORT
+  if (escalation == Mycila::ESPConnect::Escalation::INTERFACE_RESTART)
+    escalation = Mycila::ESPConnect::Escalation::SYSTEM_RESTART;
+  #endif
+  _escalationLevel = static_cast<uint8_t>(escalation) + 1;
+  _escalations[static_cast<size_t>(escalation)]++;
+
+  LOGW(TAG, "Watchdog: %s for %" PRIu32 " ms: %s", getStateName(), now - _watchdogSince, getEscalationName(escalation));
+  _watchdogSince = now;
+
+  switch (escalation) {
+    case Mycila::ESPConnect::Escalation::RECONNECT:
+      WiFi.reconnect();
+      break;
+
+    case Mycila::ESPConnect::Escalation::RADIO_RESTART:
+      WiFi.disconnect(true);
+      WiFi.mode(WIFI_MODE_NULL);
+      _lastTime = -1;
+      _setState(Mycila::ESPConnect::State::NETWORK_ENABLED);
+      break;
+
+    case Mycila::ESPConnect::Escalation::INTERFACE_RESTART:
+  #ifdef ESPCONNECT_ETH_SUPPORT
+      // only the stuck interface is restarted, the other one keeps running:
+      // Ethernet when its link is up without an IP address or when there is no WiFi, WiFi otherwise
+      if (!_config.wifiSSID.length() || (ETH.linkUp() && !ETH.hasIP())) {
+        LOGW(TAG, "Watchdog: restarting Ethernet");
+        ETH.end();
+        _startEthernet();
+      } else {
+        LOGW(TAG, "Watchdog: restarting WiFi");
+        _startSTA();
+      }
+  #endif
+      break;
+
+    case Mycila::ESPConnect::Escalation::SYSTEM_RESTART:
+      // NVS is only written here, so that the escalations do not wear the flash:
+      // the counters of the other steps are persisted with this one, and repeated restarts are visible after boot
+      _saveEscalations(_outage ? now - _outageSince : 0);
+      ESP.restart();
+      break;
+  }
+}
+
+#endif
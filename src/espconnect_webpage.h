@@ -3,345 +3,314 @@
 #ifndef _espconnect_webpage_h
 #define _espconnect_webpage_h
 
-const uint32_t ESPCONNECT_HTML_SIZE = 10095;
+const uint32_t ESPCONNECT_HTML_SIZE = 9074;
+const uint32_t ESPCONNECT_HTML_LENGTH = 25349;
+const uint32_t ESPCONNECT_HTML_CRC32 = 0x0bd6566f;
+// gzip header + non-final deflate blocks: the last block and the gzip trailer are appended when served
 const uint8_t ESPCONNECT_HTML[] PROGMEM = { 
-31,139,8,0,0,0,0,0,2,3,196,90,119,123,179,56,18,255,251,222,79,193,122,203,155,236,2,47,96,155,
-56,56,201,245,222,123,47,50,8,163,39,180,19,34,78,150,135,239,126,106,196,26,131,77,174,167,24,107,230,55,
-195,52,132,52,112,247,209,183,126,250,205,95,253,254,103,223,182,50,86,228,15,239,238,196,193,202,81,185,191,95,
-224,114,33,8,24,37,15,239,190,114,87,96,134,172,56,67,180,193,236,254,125,203,82,103,243,254,149,94,162,2,
-223,191,127,34,248,80,87,148,189,183,226,170,100,184,228,184,3,73,88,118,159,224,39,18,99,71,14,108,82,18,
-70,80,238,52,49,202,241,189,47,149,52,236,37,199,15,239,44,254,243,185,253,121,132,82,134,41,63,238,112,90,
-81,220,237,170,103,167,33,95,146,114,31,145,50,195,148,176,94,152,105,210,119,21,77,48,117,56,101,155,242,115,
-11,50,142,194,192,93,127,218,239,170,228,165,139,171,188,162,209,199,129,23,44,131,27,5,73,81,65,242,151,104,
-241,139,106,87,177,106,97,91,139,239,225,252,9,51,18,35,235,39,184,197,128,34,6,95,167,220,108,254,165,65,
-101,227,52,220,140,212,56,151,239,134,184,80,227,3,38,251,140,69,75,207,219,230,152,49,110,86,83,163,88,88,
-233,185,158,207,81,57,41,177,147,41,20,151,235,119,121,21,63,254,189,173,24,238,180,31,57,78,25,71,47,41,
-46,172,166,202,73,98,125,156,248,226,119,91,32,186,39,165,6,12,35,202,85,137,97,141,146,68,156,199,23,114,
-190,187,230,7,67,185,245,121,148,163,134,57,113,70,242,164,211,162,220,119,86,21,145,215,187,187,150,127,43,109,
-125,32,101,221,178,63,178,151,26,223,43,202,159,77,18,197,13,102,128,210,180,187,130,176,63,119,59,20,63,238,
-105,213,150,137,163,99,190,92,47,209,202,223,42,207,184,83,190,225,20,224,57,20,37,164,109,56,100,197,33,91,
-45,158,166,233,54,110,105,195,191,215,21,41,25,166,219,132,52,117,142,94,120,49,200,72,74,15,65,42,124,122,
-146,139,27,158,139,76,167,197,221,112,238,56,51,82,70,234,131,192,33,166,158,181,20,67,134,159,153,131,114,178,
-47,163,24,75,107,36,37,193,113,69,17,35,85,25,149,85,137,21,145,81,94,41,188,130,139,168,173,107,76,99,
-212,224,237,33,35,12,203,211,98,142,60,80,84,15,145,143,210,42,110,27,123,24,101,213,19,166,54,96,1,206,
-56,65,26,53,102,140,37,100,254,128,0,160,67,252,144,93,40,0,25,82,2,36,31,92,112,58,193,144,104,36,
-184,106,153,8,253,177,12,255,200,115,140,118,57,78,254,108,143,8,99,7,33,19,58,3,121,208,110,131,217,233,
-26,75,112,138,218,156,109,43,81,24,236,133,23,198,122,108,19,72,149,65,7,73,27,193,167,209,211,238,64,201,
-139,144,233,228,94,84,50,66,76,39,252,188,18,8,1,90,230,102,0,72,28,98,171,15,142,46,4,123,154,58,
-142,195,4,2,58,57,6,64,7,70,136,177,253,242,50,174,17,197,37,219,190,197,120,80,29,35,166,10,245,37,
-193,11,114,151,34,0,116,204,227,166,203,102,94,221,52,236,76,1,205,171,131,56,168,239,114,42,38,231,20,48,
-58,147,159,81,81,207,193,64,206,230,148,205,161,102,243,56,173,247,159,146,152,207,237,220,41,102,4,222,154,239,
-249,249,99,238,28,29,72,179,90,254,205,92,134,113,142,17,181,199,180,179,81,135,124,24,0,200,134,198,67,254,
-219,203,21,50,230,125,129,101,10,89,227,210,132,66,231,100,102,131,49,83,118,64,215,76,224,102,202,11,104,154,
-137,241,76,25,1,93,255,94,62,224,20,2,212,143,170,122,6,4,114,116,73,209,12,102,46,111,211,58,223,140,
-159,201,229,156,250,25,248,219,242,59,59,97,204,232,239,224,213,20,87,137,121,67,231,139,205,85,186,78,195,201,
-13,135,177,131,216,132,159,234,173,85,228,89,158,27,128,125,128,28,114,234,90,80,39,150,243,53,61,127,74,184,
-179,131,155,32,97,126,154,87,7,231,37,202,72,146,224,82,104,122,80,30,64,115,95,55,64,106,231,3,119,125,
-99,187,184,154,62,163,90,9,151,214,218,88,85,195,221,216,96,169,246,92,154,232,245,70,2,100,108,193,50,58,
-65,12,143,8,140,20,211,68,135,155,139,114,192,194,5,34,144,82,240,44,100,128,82,182,197,14,195,243,214,168,
-105,14,220,13,64,108,48,162,49,20,101,56,63,25,63,51,64,104,41,4,28,48,126,212,4,158,79,118,37,169,
-127,190,182,133,32,162,24,217,13,206,113,204,58,231,128,119,143,132,57,168,174,49,162,168,140,177,218,247,189,97,
-202,129,65,215,251,250,233,138,148,13,142,12,37,213,65,105,31,55,66,182,103,54,171,110,40,139,65,85,234,141,
-96,201,230,75,228,123,222,167,227,148,194,107,109,72,25,36,195,244,142,89,48,201,0,96,164,26,208,141,132,3,
-58,72,59,96,128,228,3,22,40,129,49,131,97,112,106,179,28,198,228,150,2,176,81,26,128,108,22,136,166,15,
-101,162,134,186,88,212,160,155,218,254,24,27,95,133,53,103,14,110,198,213,123,30,86,20,145,2,237,241,135,230,
-105,255,197,115,145,111,91,150,110,236,59,62,178,248,168,108,238,23,25,99,117,244,225,195,225,112,112,15,75,183,
-162,251,15,129,231,121,2,191,176,68,79,238,27,213,243,253,194,179,60,107,233,89,155,133,165,122,114,139,165,183,
-120,184,171,17,203,172,148,228,249,253,226,211,96,169,106,113,97,37,247,139,31,123,182,151,135,246,38,15,157,205,
-226,195,195,157,208,246,240,254,218,82,77,15,75,118,156,172,178,114,40,174,49,98,67,225,57,146,46,167,142,30,
-56,111,92,23,210,153,255,131,115,50,226,23,157,211,38,255,177,104,115,70,234,28,155,221,44,117,1,234,171,13,
-181,172,234,135,92,119,5,41,29,205,8,85,207,45,71,59,156,219,57,222,227,50,233,224,100,13,58,134,83,109,
-170,147,190,156,82,152,18,156,39,13,102,67,17,73,47,141,134,31,156,166,51,28,63,242,169,2,54,67,80,66,
-170,63,119,176,117,214,187,210,82,71,141,186,169,190,26,176,175,172,104,129,114,216,131,84,6,186,49,135,33,46,
-69,187,215,27,167,136,18,199,62,107,107,125,31,222,71,45,53,172,26,34,219,102,20,231,136,145,39,108,78,84,
-46,173,14,175,86,165,57,126,222,138,15,39,33,20,199,82,40,174,242,182,40,143,58,79,133,197,191,195,171,84,
-3,186,87,224,20,247,193,85,234,166,80,226,206,222,201,147,139,111,145,248,56,50,89,85,119,178,37,232,16,134,
-139,38,146,184,134,33,202,142,24,149,207,49,140,87,200,17,164,46,46,0,82,164,35,164,97,20,179,56,3,24,
-77,51,78,134,26,44,82,8,80,3,81,194,172,193,87,88,157,194,164,200,183,124,153,59,152,103,51,147,60,188,
-70,164,129,66,125,112,170,52,109,48,115,124,175,51,181,248,151,209,1,68,7,51,232,53,68,175,47,162,151,75,
-251,18,119,5,116,45,151,238,146,255,92,84,184,130,198,174,46,27,187,134,232,245,101,116,8,209,225,12,58,180,
-47,113,111,160,174,208,13,249,207,69,133,55,48,178,55,151,35,187,129,198,110,46,27,123,11,209,183,211,104,81,
-56,178,24,197,204,206,171,6,84,223,180,68,96,72,4,64,34,56,39,177,54,36,214,64,98,218,227,115,69,180,
-92,29,21,233,210,49,181,93,172,166,149,97,246,10,152,125,174,162,214,134,196,26,72,156,171,170,208,144,8,129,
-196,185,202,58,83,82,225,141,161,72,21,18,208,118,169,182,110,140,104,223,128,104,159,171,175,141,97,246,6,152,
-125,174,198,110,13,137,91,83,98,84,103,195,209,152,188,27,156,167,112,238,30,195,225,60,46,36,192,52,62,194,
-195,41,93,226,21,165,255,90,129,19,130,174,10,82,106,11,121,246,41,46,174,59,121,211,59,185,207,113,18,152,
-141,29,255,184,164,143,81,30,95,137,121,216,250,194,10,132,6,96,8,124,206,55,108,27,140,187,176,208,212,247,
-8,110,156,39,31,106,245,195,178,22,233,189,54,236,148,36,185,93,229,118,155,119,57,105,152,35,159,232,74,49,
-109,184,218,111,14,39,214,55,21,46,100,113,57,254,89,201,207,150,235,144,148,74,82,42,73,105,37,165,149,148,
-86,80,186,227,34,138,167,85,235,143,212,206,151,39,94,127,145,139,208,10,152,195,29,34,5,202,45,82,54,36,
-193,61,180,53,38,52,206,177,230,157,62,14,77,18,59,97,118,78,78,194,233,155,139,51,181,220,210,139,254,215,
-173,192,137,196,232,169,172,205,125,75,201,190,165,216,22,143,10,69,12,107,187,230,35,38,250,26,34,158,80,65,
-160,20,72,174,92,14,154,79,49,97,103,224,216,82,120,150,75,86,243,225,165,136,191,121,15,103,137,205,178,65,
-159,62,21,220,168,110,194,91,180,219,28,187,13,110,96,60,101,102,73,148,18,170,31,46,11,85,230,176,131,73,
-23,224,28,25,88,99,212,193,141,132,119,254,50,81,1,24,252,149,35,211,95,253,150,65,223,239,236,134,209,170,
-220,119,230,66,118,87,229,73,95,119,102,101,246,153,111,103,129,157,45,237,108,101,103,107,59,11,187,153,167,249,
-142,126,104,124,146,31,73,130,138,141,130,93,185,33,29,189,2,16,244,89,96,96,150,147,152,117,159,45,13,80,
-224,110,198,160,101,159,173,0,70,90,51,182,219,155,146,229,39,88,31,133,57,101,115,70,120,61,22,230,178,33,
-144,13,39,100,189,19,161,85,79,138,125,7,215,149,189,43,251,122,41,121,86,111,129,116,114,200,19,198,178,173,
-126,171,36,90,88,139,45,72,124,239,242,172,35,38,235,171,147,95,101,125,107,178,170,37,77,23,223,57,67,94,
-9,69,203,112,50,204,98,97,16,222,220,120,214,71,164,168,43,202,80,169,65,195,4,62,122,238,223,187,7,135,
-27,220,153,166,103,146,162,252,211,164,196,17,83,57,216,196,128,115,8,130,163,166,234,166,155,220,221,104,12,173,
-14,35,0,167,245,110,177,115,130,110,92,131,189,91,83,199,135,215,147,154,175,184,225,98,54,208,150,139,175,99,
-175,155,194,204,102,80,63,139,188,144,248,81,68,91,152,114,220,35,201,57,87,36,123,52,119,140,59,139,162,25,
-166,183,123,167,141,50,209,80,109,172,184,221,145,216,217,225,47,9,166,87,158,27,248,107,155,51,66,95,124,46,
-215,124,224,95,219,214,177,43,246,102,161,81,123,77,148,240,233,107,37,7,142,113,118,20,163,199,72,126,58,130,
-112,226,183,190,243,25,141,57,186,223,161,171,219,91,219,26,254,185,231,215,150,87,63,91,1,255,223,168,99,127,
-166,7,9,251,89,67,80,245,28,47,239,230,70,106,182,167,103,13,188,149,109,5,254,45,255,88,6,226,196,129,
-58,241,146,255,135,252,223,231,255,164,20,119,38,75,225,69,48,134,15,129,95,41,188,167,241,225,128,215,225,82,
-183,111,163,14,194,26,20,175,234,130,13,29,248,209,227,22,101,228,234,198,182,194,165,109,109,164,133,222,250,218,
-84,222,187,121,181,175,134,150,129,116,90,78,169,162,105,19,241,244,136,182,233,55,133,46,94,230,136,215,183,209,
-101,56,46,122,79,194,4,250,215,162,186,121,10,17,77,192,37,56,110,59,128,46,250,73,185,248,176,127,58,202,
-131,191,226,41,240,215,55,252,35,148,113,245,215,34,176,58,251,171,250,121,107,180,136,130,91,206,81,38,89,70,
-215,196,60,189,76,252,176,2,233,38,75,119,246,74,18,51,45,162,255,172,169,32,191,227,247,94,186,227,91,49,
-183,156,203,74,39,23,62,77,102,254,202,247,121,214,253,192,23,31,183,215,134,94,29,221,183,64,69,125,160,228,
-216,84,146,233,212,52,139,55,237,142,125,248,146,20,114,165,234,148,168,192,81,83,147,114,59,69,27,227,147,86,
-47,113,253,181,231,21,205,246,60,103,44,75,24,86,16,39,230,206,179,136,148,41,41,57,113,59,15,153,208,198,
-72,33,102,234,180,45,213,236,174,83,56,7,232,191,54,168,122,196,47,41,229,174,54,150,240,181,75,105,85,116,
-199,119,208,104,197,16,195,87,94,130,247,215,61,171,198,156,101,168,120,253,215,254,83,138,100,137,140,51,168,175,
-37,94,114,186,161,42,191,194,58,231,91,217,241,69,58,14,90,164,180,251,158,211,166,116,93,62,82,203,111,44,
-140,26,108,161,156,97,90,114,115,44,144,149,127,90,106,170,100,184,57,226,26,88,53,219,73,162,88,246,57,220,
-37,211,255,72,191,212,10,72,250,253,214,215,117,205,226,232,50,218,53,85,222,50,252,198,88,253,63,34,211,79,
-249,162,183,167,124,38,185,16,184,160,217,78,17,39,226,213,137,117,203,188,194,16,42,28,136,83,151,198,169,131,
-157,247,169,121,59,247,228,76,232,89,142,56,136,119,19,123,223,155,70,72,102,255,181,255,154,230,119,46,166,180,
-146,239,52,187,205,19,206,25,118,124,150,221,188,172,25,124,188,156,224,91,124,59,188,181,176,243,60,47,240,134,
-91,172,207,213,13,43,176,117,28,196,129,241,128,240,230,120,183,133,213,228,174,225,14,70,17,224,46,71,209,250,
-119,252,213,237,15,250,221,237,187,15,234,77,241,59,241,190,53,63,36,228,201,34,201,253,2,213,245,130,63,97,
-225,67,78,108,98,74,106,246,240,238,9,81,139,51,238,135,169,236,234,186,91,180,13,182,26,70,73,204,22,219,
-129,110,49,206,233,95,71,248,138,93,119,20,179,150,74,206,145,81,254,131,115,107,241,106,27,87,250,255,138,241,
-225,203,149,79,181,46,233,187,9,106,78,74,233,45,247,2,229,46,236,147,143,195,49,142,210,248,146,216,217,72,
-41,5,146,255,253,251,141,198,182,108,200,183,239,221,88,26,201,163,209,188,165,49,162,134,127,190,250,175,78,109,
-156,46,52,185,162,124,57,157,54,230,25,66,96,99,104,234,126,146,78,132,110,12,165,30,119,88,1,67,165,40,
-67,43,198,129,245,19,11,97,165,246,100,108,41,59,208,74,233,30,90,74,175,86,182,211,9,11,71,67,227,237,
-213,234,247,113,78,25,167,141,169,158,156,143,246,232,40,220,162,46,163,9,50,167,41,148,161,45,236,123,103,110,
-2,176,213,234,193,38,19,222,36,23,157,143,139,145,142,33,43,164,173,140,213,54,102,46,26,252,28,21,233,114,
-166,243,138,115,251,83,77,189,214,244,229,31,78,63,62,21,191,87,176,147,77,108,163,255,31,219,153,254,230,8,
-111,173,62,19,126,186,192,17,176,49,52,110,13,53,71,230,204,55,105,188,192,98,152,192,254,87,44,118,152,25,
-184,93,189,16,60,65,138,72,189,179,37,175,54,77,240,88,191,86,210,32,206,43,149,15,170,215,134,22,10,140,
-172,73,67,120,61,27,127,209,182,9,217,194,212,78,199,198,166,5,150,121,3,243,132,21,65,171,48,124,162,165,
-141,111,38,197,148,216,225,148,171,211,17,54,166,154,169,106,170,198,151,74,119,190,38,211,165,86,76,146,30,132,
-97,79,251,73,55,158,15,60,193,17,237,76,183,36,253,100,81,204,161,87,183,76,57,143,128,80,15,166,183,7,
-97,157,154,133,61,98,244,84,219,224,202,155,235,54,201,244,74,53,52,251,27,68,147,141,197,214,85,100,39,116,
-45,153,235,155,96,159,252,154,8,63,214,166,151,76,145,93,6,197,210,210,213,91,144,22,88,35,7,255,131,242,
-18,39,187,75,156,229,68,253,82,134,87,30,255,45,173,136,69,226,237,237,184,200,47,103,148,100,197,243,165,153,
-180,116,231,82,68,20,101,141,13,172,194,228,18,143,219,211,125,74,95,111,76,41,193,237,25,181,213,93,171,251,
-53,20,161,156,158,42,75,152,137,66,114,186,230,92,95,244,177,157,180,66,87,120,23,70,12,190,191,90,94,1,
-145,233,229,192,36,55,97,174,241,182,85,158,21,78,132,123,75,3,247,234,58,126,187,105,76,140,104,12,9,75,
-194,128,212,101,186,126,188,137,117,227,69,131,195,171,22,81,237,241,132,198,214,180,219,15,144,20,209,58,138,228,
-86,17,243,87,239,16,182,38,244,122,180,102,4,91,59,235,53,211,123,170,206,47,228,53,253,236,209,207,17,253,
-236,43,40,199,44,51,164,65,136,50,95,53,24,75,250,112,130,189,122,149,56,35,1,237,213,34,97,116,135,138,
-244,224,84,91,247,194,177,218,241,243,223,55,68,117,213,31,21,247,32,93,244,143,119,79,227,169,206,191,224,22,
-200,15,159,158,31,95,244,143,159,60,145,164,118,242,147,32,81,69,107,154,191,205,142,95,86,47,169,29,73,139,
-92,215,56,174,227,121,49,23,17,40,166,233,68,132,197,184,221,221,171,102,216,39,170,91,173,164,213,222,185,189,
-232,31,198,147,196,192,60,86,43,113,72,78,4,77,137,61,71,235,189,122,149,245,13,124,172,22,213,178,140,189,
-127,84,47,123,84,47,75,76,146,135,124,217,37,34,185,221,82,87,108,197,89,13,109,2,134,111,99,100,24,95,
-72,89,200,204,151,115,184,0,172,43,13,54,204,89,215,37,195,162,126,69,47,220,68,6,163,237,151,79,117,254,
-93,247,66,122,52,157,142,111,199,115,160,73,237,55,210,38,27,187,164,171,68,87,43,205,89,84,169,193,93,75,
-110,67,47,181,3,72,109,168,238,23,189,29,153,246,160,27,243,222,112,237,247,243,153,70,227,197,106,101,196,48,
-78,35,57,84,195,120,238,135,63,178,7,115,100,101,112,114,119,208,71,224,215,36,85,64,192,231,6,111,126,244,
-158,12,28,114,239,20,174,121,231,196,99,163,136,117,183,127,71,50,34,20,88,146,213,79,8,50,236,38,118,131,
-213,156,75,30,137,46,122,36,204,136,214,44,40,248,234,169,209,1,102,0,236,151,255,175,176,37,165,105,19,252,
-155,51,201,66,78,75,157,185,175,216,219,203,100,229,150,122,9,53,71,154,238,163,111,123,11,217,228,117,111,185,
-118,158,166,143,253,103,241,76,0,87,36,167,171,213,25,136,246,222,40,87,9,238,65,230,66,195,160,51,202,199,
-69,10,91,31,44,120,123,113,28,231,81,207,136,28,59,104,186,67,216,42,237,106,233,229,217,32,252,39,230,125,
-137,159,105,40,213,46,111,232,139,0,218,216,83,31,201,230,160,111,199,206,40,154,51,27,88,92,104,194,32,148,
-13,36,53,104,248,192,52,124,215,85,202,17,192,74,123,190,115,129,117,79,43,207,33,79,96,119,176,154,29,185,
-31,219,137,206,197,123,236,201,207,38,134,76,197,78,11,118,174,159,62,239,174,118,46,86,170,187,187,171,255,231,
-121,215,47,249,189,208,50,37,121,201,76,46,228,82,142,156,137,84,124,152,193,243,108,139,218,158,198,74,3,167,
-242,50,117,27,193,54,184,49,71,136,52,144,103,41,73,40,66,97,47,245,111,203,100,10,225,95,241,199,67,34,
-242,106,0,243,240,252,169,122,153,193,90,185,78,221,112,203,170,1,104,171,10,250,152,75,215,136,61,178,198,35,
-40,68,26,151,16,240,104,54,152,129,218,10,128,217,224,73,29,191,28,37,142,57,189,145,52,215,217,252,146,9,
-132,51,90,20,133,237,165,177,69,158,175,129,199,33,33,216,186,191,236,116,150,98,236,58,236,225,231,228,225,97,
-114,99,39,203,98,80,16,55,99,199,135,213,234,126,45,133,179,6,232,163,105,70,82,83,186,193,129,129,104,123,
-121,21,164,28,18,104,61,99,131,163,149,85,67,165,17,52,96,107,28,123,66,59,157,113,236,26,24,110,182,97,
-8,114,222,233,124,0,33,22,251,205,161,240,196,167,177,247,150,115,82,29,131,69,218,46,83,142,189,126,110,109,
-77,59,157,41,211,17,201,146,21,236,137,211,120,114,59,90,224,5,31,125,42,93,106,164,177,195,197,34,129,38,
-34,42,146,79,165,116,155,178,88,100,142,162,70,214,31,55,12,199,183,227,41,59,187,202,68,147,210,253,108,158,
-77,190,167,79,89,1,52,168,211,249,40,72,61,125,140,144,191,9,93,83,143,6,82,131,73,177,64,35,229,12,
-98,170,121,26,34,237,122,91,204,16,147,167,137,49,193,191,238,183,75,157,132,183,134,91,152,100,70,194,41,210,
-51,174,70,148,93,111,23,121,219,101,208,132,118,142,100,47,160,134,155,192,100,246,149,216,115,54,108,205,121,119,
-205,213,28,187,26,233,111,159,199,100,126,223,117,225,134,156,131,49,115,151,200,88,80,180,94,111,27,109,137,235,
-116,138,212,125,94,136,96,80,22,173,172,220,193,75,229,41,16,135,115,138,216,85,56,198,132,114,118,67,165,72,
-47,60,14,18,195,166,57,88,215,123,143,31,104,117,50,4,93,238,230,62,21,148,180,35,169,197,57,55,140,164,
-198,46,114,189,248,116,118,116,168,254,225,142,194,142,199,42,164,20,216,85,137,194,119,77,48,87,122,0,107,79,
-13,223,13,177,224,215,196,226,200,30,12,79,130,25,180,9,86,197,167,233,224,127,243,192,253,243,232,165,95,138,
-101,112,3,119,24,92,233,96,161,185,92,132,252,218,22,189,96,55,9,38,11,61,174,63,171,236,190,125,22,119,
-95,189,137,95,196,221,167,225,187,13,192,221,167,9,159,222,91,191,255,144,95,133,150,161,91,52,196,179,186,198,
-14,184,220,21,52,171,90,56,37,72,216,3,29,151,202,83,44,0,163,50,140,38,20,104,27,156,253,165,230,172,
-204,157,131,30,201,177,156,200,43,185,45,191,201,91,121,41,79,229,181,220,147,71,114,95,158,200,51,121,40,143,
-229,123,249,73,222,41,123,254,12,14,225,159,46,222,171,45,123,254,10,189,127,83,239,0,67,47,209,249,15,58,
-125,159,145,180,15,241,231,207,47,6,191,246,126,118,199,153,143,10,131,145,252,81,125,196,227,145,124,233,158,19,
-2,206,189,172,83,223,44,26,205,77,26,224,69,29,52,106,139,16,251,188,26,165,98,94,224,139,147,225,187,61,
-142,10,16,94,240,83,246,49,219,125,58,175,69,48,82,51,1,255,229,215,156,248,230,21,53,93,125,6,157,111,
-110,226,93,167,115,71,142,67,222,186,238,176,211,25,186,238,165,235,30,116,58,7,174,123,234,186,215,30,213,158,
-111,30,81,147,139,2,232,237,171,165,8,233,88,143,216,76,77,250,220,22,237,51,135,224,208,191,117,220,122,235,
-71,90,5,234,83,120,245,33,165,37,208,149,12,233,106,4,16,226,64,5,66,209,38,213,56,6,143,244,2,35,
-167,167,7,31,170,145,108,4,128,49,120,96,195,113,85,165,80,36,77,158,64,151,205,116,154,132,88,9,107,49,
-30,187,153,11,4,103,24,5,89,190,235,37,163,207,249,244,86,109,147,222,60,163,87,39,158,182,82,92,252,32,
-195,117,139,143,31,19,159,62,124,199,65,115,15,245,166,79,3,39,50,36,234,143,158,117,131,110,247,240,85,252,
-162,251,34,232,82,59,126,189,243,58,120,233,126,187,184,20,125,251,60,120,225,126,81,19,124,243,10,245,145,10,
-218,125,203,115,186,252,120,227,128,37,30,204,238,226,247,206,173,180,47,67,247,41,117,40,127,239,106,166,156,233,
-110,155,49,179,251,170,130,240,173,115,11,84,126,118,13,152,251,114,238,5,254,195,208,13,13,81,22,6,56,221,
-96,86,32,212,75,109,134,40,192,213,115,12,206,178,209,104,170,29,178,163,74,226,94,63,0,244,60,99,104,80,
-87,154,90,102,3,125,124,36,244,189,71,146,227,98,119,64,197,112,135,253,184,94,146,255,158,136,129,143,150,116,
-197,253,7,203,29,63,90,238,112,163,208,175,219,66,175,203,247,24,252,171,110,211,200,132,227,220,162,159,161,163,
-209,149,83,224,200,233,1,15,73,15,184,73,126,140,248,49,166,7,188,38,61,224,58,35,249,5,182,96,145,115,
-241,240,183,210,21,204,208,166,252,149,161,183,165,71,104,67,47,217,49,180,160,90,158,242,227,154,30,240,198,244,
-128,75,166,7,252,50,61,224,156,121,236,140,31,135,244,128,175,134,245,3,213,113,137,234,61,178,132,79,234,124,
-14,234,74,87,5,42,187,93,144,57,103,29,64,221,157,64,111,28,68,215,2,147,98,1,254,191,190,144,27,50,
-48,27,207,249,14,227,3,223,104,192,213,44,92,10,194,249,140,165,243,221,133,124,15,203,7,123,231,28,4,222,
-116,232,102,173,237,64,176,228,11,2,111,35,151,16,165,99,136,220,44,239,46,34,217,165,41,87,124,241,134,137,
-214,29,89,60,183,233,165,193,221,224,46,230,133,122,226,78,185,0,197,110,152,37,112,139,68,245,142,207,188,162,
-11,160,98,222,80,0,27,12,1,31,50,124,200,240,222,112,48,172,177,13,149,11,112,236,197,73,114,36,175,72,
-82,184,27,28,12,14,234,121,7,138,98,159,100,247,238,101,137,133,33,91,113,192,11,28,148,11,51,51,142,30,
-50,227,35,241,129,35,35,177,225,71,126,201,197,72,60,8,2,236,45,241,70,21,174,7,86,211,14,254,165,46,
-142,170,128,52,170,66,17,53,104,149,136,132,213,149,70,124,106,229,9,255,124,152,39,44,57,83,216,152,143,61,
-14,215,238,207,30,208,41,154,97,114,233,2,215,136,64,102,158,228,33,218,49,57,128,61,46,207,169,240,243,92,
-35,111,213,246,166,88,92,7,34,47,130,234,203,141,40,164,128,86,59,150,234,15,48,104,129,246,230,219,113,194,
-207,227,72,241,251,49,71,183,99,142,119,15,191,239,24,138,216,45,67,4,64,167,28,116,89,187,139,49,76,112,
-66,38,88,16,53,73,254,69,59,27,132,174,203,135,48,72,14,22,183,193,112,138,135,186,242,234,5,195,155,11,
-63,18,251,152,165,58,105,73,245,223,77,169,154,74,174,127,44,83,227,197,72,156,50,181,36,42,1,85,224,118,
-46,65,9,85,112,242,96,74,54,106,191,103,30,73,208,108,78,44,120,4,21,122,62,108,132,208,52,103,197,100,
-13,189,55,64,228,243,142,130,51,212,191,43,117,240,5,82,199,67,203,162,37,117,67,190,222,64,90,47,32,134,
-37,100,59,82,115,244,27,222,213,13,108,16,162,217,44,196,148,204,190,189,143,78,231,209,62,171,217,5,205,230,
-189,57,103,217,220,49,156,229,43,154,99,26,222,242,5,121,203,138,222,182,126,16,145,93,64,90,234,241,159,7,
-234,241,167,20,195,219,61,240,195,53,58,57,121,166,214,53,214,160,93,99,253,251,54,105,89,58,246,177,116,232,
-1,178,61,239,159,63,35,150,76,32,73,162,236,119,142,69,63,111,62,112,98,75,97,121,64,248,75,167,172,95,
-255,224,252,218,222,153,47,202,255,165,69,172,21,154,87,113,194,82,250,188,11,121,255,32,200,235,110,113,231,23,
-204,104,82,144,66,227,92,28,201,157,43,46,160,82,174,107,212,88,148,75,235,114,22,183,37,145,145,75,205,115,
-155,64,131,6,243,25,37,27,208,135,245,6,41,44,34,85,68,1,175,66,88,114,95,39,165,237,68,61,96,23,
-41,135,183,180,10,198,244,114,1,120,193,240,130,225,189,98,80,212,65,182,80,116,116,149,76,47,81,98,154,136,
-77,4,98,178,30,84,163,103,29,195,120,19,212,146,142,117,121,185,3,15,49,45,102,106,203,252,174,174,93,140,
-186,228,106,203,253,21,29,128,122,233,90,105,121,239,154,133,107,22,136,85,189,169,107,38,243,75,186,56,232,101,
-174,55,75,114,186,153,76,96,95,212,95,224,9,99,11,67,57,162,159,153,154,246,19,115,155,167,65,171,184,154,
-139,231,52,115,7,146,17,47,221,76,190,8,180,174,30,240,17,103,226,15,137,77,250,85,253,90,132,142,170,80,
-130,227,152,42,61,156,193,197,3,176,247,183,114,249,112,168,164,62,148,217,106,181,213,109,142,240,78,66,153,184,
-129,190,93,220,214,245,154,228,38,201,108,48,214,22,87,105,225,83,109,230,229,229,234,211,242,25,130,15,218,78,
-138,81,47,60,249,124,122,22,74,250,104,193,221,166,254,240,253,225,169,251,35,226,147,100,145,204,12,149,101,120,
-171,41,54,221,88,195,150,107,104,151,34,64,22,217,152,196,234,11,48,118,145,205,0,134,222,199,238,207,73,204,
-79,153,5,49,247,97,52,248,215,233,231,99,210,14,163,233,110,106,166,141,73,190,104,218,119,79,163,208,146,16,
-209,64,181,46,83,90,28,209,148,98,44,118,105,6,6,76,92,166,41,94,162,77,240,187,16,127,212,99,201,128,
-227,28,215,120,167,44,193,36,131,99,143,131,147,169,251,146,7,7,178,108,124,27,220,22,203,69,144,194,57,235,
-156,138,172,38,6,219,89,206,196,102,237,9,41,233,40,37,127,92,230,63,206,113,214,56,193,152,32,249,130,195,
-76,27,11,217,201,122,125,43,132,211,41,119,209,71,5,158,49,217,180,182,103,217,76,23,75,203,37,142,27,220,
-251,21,55,49,253,245,56,17,189,249,134,10,81,68,191,160,34,77,125,141,104,249,218,78,89,160,46,181,46,3,
-20,119,134,226,45,69,224,216,193,34,25,182,134,118,100,129,161,114,132,76,165,30,233,238,200,41,134,8,134,161,
-82,249,252,168,204,48,88,66,49,206,42,88,15,63,147,9,134,25,8,131,39,218,202,11,104,229,246,222,221,121,
-246,166,227,235,19,224,4,116,55,23,175,200,236,200,67,156,23,50,147,9,23,36,228,76,142,101,227,251,24,200,
-157,174,81,201,5,167,114,218,28,41,220,21,44,199,85,233,246,134,57,141,241,25,143,151,217,152,116,235,69,210,
-81,75,15,218,49,94,112,4,206,104,23,47,156,63,104,227,88,182,215,192,148,104,125,81,94,28,231,54,128,9,
-192,36,113,135,204,6,176,88,166,182,88,144,238,152,229,92,83,125,243,251,242,252,37,181,149,214,202,66,150,126,
-235,173,116,143,29,233,252,21,72,169,156,85,87,150,142,234,217,186,121,243,106,30,249,65,91,213,184,43,141,48,
-200,62,16,108,242,11,105,252,123,169,15,70,205,128,147,55,178,134,223,191,176,107,221,205,250,147,123,27,220,62,
-237,191,251,253,107,191,214,53,223,113,17,36,206,168,3,247,53,186,9,160,82,11,202,189,219,119,175,237,27,216,
-124,99,246,161,57,56,231,28,0,171,120,195,81,166,21,83,10,219,200,167,220,225,85,26,220,208,215,21,113,141,
-138,184,222,205,171,226,181,166,138,184,65,52,85,153,21,198,150,75,180,226,119,187,150,110,90,181,116,186,255,119,
-117,11,237,131,57,196,216,94,204,60,90,44,230,121,125,159,111,80,196,77,93,81,230,121,39,101,250,11,71,115,
-185,135,2,152,10,79,118,209,40,228,79,85,73,119,17,245,205,121,113,49,160,31,132,240,41,16,246,4,117,104,
-111,136,248,14,158,10,110,128,4,221,12,230,84,142,166,245,176,138,105,173,226,38,83,134,208,175,224,170,34,99,
-93,230,73,91,205,207,69,252,238,115,208,156,239,218,10,91,78,216,44,84,184,211,193,47,225,132,44,41,81,142,
-228,134,68,107,218,148,99,43,161,243,23,180,249,255,245,118,109,187,109,28,103,248,190,79,193,58,170,33,161,179,
-204,158,184,75,74,161,137,152,136,97,3,118,109,84,129,114,225,10,130,76,46,69,73,52,117,224,74,150,108,24,
-232,11,20,189,104,239,26,52,109,159,162,215,125,148,188,64,243,8,253,190,249,103,119,56,171,93,198,68,21,71,
-1,231,244,207,113,231,255,231,63,205,216,42,104,101,227,136,242,209,87,65,56,242,189,160,29,248,145,231,183,187,
-189,212,11,249,7,61,229,94,138,130,16,110,130,41,126,195,56,242,58,252,219,77,85,204,148,74,85,122,29,61,
-77,70,82,87,1,84,153,250,42,188,238,142,124,101,242,153,167,66,254,77,161,187,28,153,92,21,74,111,8,195,
-189,32,124,223,122,209,83,169,30,72,210,137,81,53,138,19,47,82,145,23,45,34,73,41,164,208,95,111,47,21,
-165,102,246,201,74,205,204,42,53,195,88,114,172,82,211,102,53,42,53,179,82,169,185,124,31,161,64,182,133,225,
-132,133,185,95,205,16,31,231,117,226,237,68,29,253,188,121,67,125,173,158,169,151,90,14,107,47,160,69,61,156,
-253,22,204,218,19,201,160,119,59,147,123,146,212,132,149,233,19,73,95,34,205,228,133,8,102,250,104,131,153,147,
-60,139,245,2,176,14,116,20,198,54,69,98,95,79,188,170,179,130,92,217,232,132,194,202,79,63,252,237,251,214,
-127,254,209,66,250,136,69,114,53,143,74,121,148,190,132,27,12,129,126,67,147,5,35,128,252,241,239,127,21,240,
-91,100,60,41,140,21,187,182,217,83,167,153,83,87,97,243,152,214,130,237,7,106,168,107,189,64,19,123,52,91,
-152,166,255,248,47,52,45,70,52,247,63,26,52,156,102,95,185,205,254,30,205,162,85,99,232,64,115,39,52,114,
-176,213,241,99,26,135,30,235,130,167,118,144,23,15,31,94,136,206,143,37,216,111,187,150,114,219,83,160,101,110,
-94,113,219,17,98,249,214,36,0,163,206,185,104,138,206,106,149,206,79,27,52,223,98,156,88,165,145,94,212,104,
-164,235,197,223,26,153,183,229,92,143,42,208,226,176,64,139,195,122,9,216,106,173,129,2,12,128,7,18,28,49,
-0,70,72,176,33,153,55,18,220,74,133,3,9,118,25,0,95,36,24,74,240,66,130,111,36,120,37,193,183,18,
-60,151,224,119,210,251,99,9,158,154,175,243,22,11,104,53,220,239,161,142,132,176,248,172,79,189,115,161,137,254,
-14,153,133,234,68,124,113,251,25,84,192,64,166,151,84,124,84,209,115,139,146,253,27,245,114,75,96,68,131,106,
-49,182,128,184,85,79,12,196,30,33,92,36,22,144,23,106,207,128,156,16,196,193,107,129,120,174,176,5,75,236,
-30,96,70,155,23,34,171,94,24,89,245,2,211,185,232,107,133,184,108,197,165,41,187,52,75,22,68,84,178,20,
-14,159,185,74,152,195,146,147,114,20,175,203,84,204,210,149,221,138,153,213,223,55,71,220,35,127,64,111,147,92,
-91,92,79,251,187,236,118,216,63,173,232,3,230,107,208,151,171,207,192,191,161,149,159,126,248,203,63,105,138,127,
-1,78,192,218,225,157,255,170,213,44,42,214,240,113,141,198,220,201,231,153,207,143,223,255,233,191,255,254,115,235,
-27,205,145,10,203,61,187,189,207,137,77,245,196,134,122,207,29,233,248,27,59,201,13,27,189,113,172,196,55,21,
-138,155,77,224,99,58,165,154,253,106,37,249,161,109,118,53,64,61,253,124,199,92,231,138,3,74,121,131,80,200,
-103,147,21,247,166,214,110,40,101,27,181,212,243,205,93,203,241,124,29,139,160,229,57,12,57,157,87,201,169,4,
-99,9,38,18,76,249,5,222,34,66,124,151,90,71,58,16,66,11,204,101,176,65,66,123,11,66,113,64,147,192,
-85,73,248,178,215,98,16,152,44,229,68,58,231,102,41,167,67,3,193,173,38,144,86,239,118,218,7,193,2,126,
-139,221,104,56,24,150,10,179,33,233,147,32,125,142,0,20,139,123,196,25,231,29,165,89,161,42,99,93,140,84,
-76,8,7,14,121,186,108,84,148,137,124,117,32,242,149,86,152,213,234,16,28,48,171,48,208,186,4,167,140,242,
-250,72,45,180,224,12,225,92,158,125,120,96,213,109,112,46,16,25,23,188,151,9,63,110,53,67,7,119,160,69,
-38,70,129,160,37,26,68,253,220,173,46,117,140,150,67,153,4,143,23,169,44,138,12,219,237,165,193,163,173,66,
-118,191,90,71,118,191,196,193,78,217,189,178,148,190,35,161,143,215,148,180,207,31,125,234,107,111,230,105,183,36,
-126,208,18,254,93,226,206,35,112,194,183,183,244,245,133,190,102,220,183,191,200,70,113,18,39,197,123,112,124,254,
-45,8,85,56,76,218,113,55,209,162,73,17,11,194,69,172,163,129,47,255,47,2,223,43,114,128,215,187,65,218,
-238,4,177,134,84,20,90,130,72,5,233,212,11,175,189,100,10,57,38,149,172,30,114,246,82,100,244,222,147,48,
-178,87,121,98,142,9,151,170,126,53,77,30,61,209,218,57,58,248,96,253,229,37,144,214,215,162,11,120,197,5,
-198,197,170,164,42,238,11,117,16,66,228,210,8,146,178,121,65,202,30,136,165,170,200,60,129,255,31,52,127,158,
-185,111,136,82,209,68,172,173,57,120,155,87,45,49,77,183,163,104,1,191,206,183,181,6,253,60,223,158,200,129,
-127,213,7,24,77,173,87,8,86,89,113,206,171,219,229,151,222,43,65,50,74,123,135,206,94,233,181,123,73,71,
-117,219,157,48,24,50,209,237,34,17,197,144,93,125,68,130,52,210,17,45,44,71,105,15,191,1,132,101,8,201,
-221,46,126,81,201,139,216,192,48,136,219,41,119,89,187,235,99,255,68,237,56,73,204,70,106,237,246,218,97,16,
-75,145,116,4,33,219,143,58,216,162,65,212,85,81,59,5,88,172,58,237,132,37,236,75,249,236,24,191,62,74,
-124,61,26,159,53,240,203,97,74,75,108,181,195,62,144,25,233,72,216,90,248,186,40,196,88,144,163,171,96,40,
-105,111,24,235,166,2,244,209,137,84,204,72,55,76,25,73,208,155,158,25,126,57,26,206,12,16,122,148,50,51,
-51,122,136,246,189,174,116,134,148,76,13,29,178,171,196,211,221,74,87,94,168,231,6,92,234,118,184,136,186,61,
-106,34,186,210,139,175,251,244,244,12,61,61,67,79,207,208,211,51,244,100,134,69,111,177,76,196,172,168,196,176,
-160,82,108,86,96,249,11,18,67,113,121,189,131,92,250,74,37,51,124,157,36,73,61,174,113,60,11,218,113,24,
-123,248,245,227,25,148,30,28,30,70,151,204,226,118,20,166,252,166,61,13,227,119,21,33,159,59,45,85,112,29,
-24,187,32,183,35,140,235,52,161,55,129,241,124,203,62,21,143,179,58,60,206,86,227,113,163,253,177,84,81,140,
-56,146,194,9,196,218,34,175,120,82,3,49,229,164,30,15,198,229,73,61,230,73,109,176,21,1,78,106,206,196,
-105,165,34,66,176,172,98,187,157,52,29,11,227,205,210,164,48,52,244,143,182,138,111,47,111,33,251,146,42,26,
-67,70,105,106,160,217,5,78,176,173,103,147,86,62,205,170,118,142,133,210,185,250,146,218,76,188,96,47,51,109,
-128,105,175,77,230,206,87,140,185,24,235,161,168,165,15,175,179,49,122,131,73,9,39,42,180,228,199,99,93,128,
-121,96,48,242,207,31,201,96,96,40,113,38,133,89,28,231,247,62,242,235,188,209,96,76,146,92,103,198,61,151,
-140,152,98,230,20,219,4,112,171,44,210,83,187,54,171,15,0,127,127,240,54,223,30,91,194,159,201,86,170,74,
-122,43,149,74,22,121,44,43,94,167,82,183,156,249,162,158,101,95,159,219,182,107,238,234,48,170,88,36,28,239,
-61,224,81,13,199,91,131,79,71,37,159,75,222,214,88,4,183,23,203,38,222,145,152,120,173,149,240,12,102,157,
-38,182,87,90,88,102,120,105,90,49,185,119,45,93,129,230,135,37,147,165,210,131,53,132,105,251,154,201,37,163,
-172,181,157,5,211,249,110,29,166,243,40,87,83,50,157,229,28,253,130,31,14,148,233,160,98,35,122,83,163,15,
-111,101,180,84,163,231,205,15,114,93,167,108,78,43,37,12,58,238,106,19,107,49,107,211,79,29,132,148,20,253,
-215,66,72,209,71,240,222,122,131,159,184,151,52,172,40,199,203,26,140,168,57,68,39,131,134,86,120,249,240,113,
-71,43,126,54,203,81,245,27,7,140,54,4,182,24,95,191,113,228,22,210,140,179,223,60,5,222,102,208,55,35,
-22,220,156,92,218,57,68,196,202,165,19,149,203,4,0,114,70,144,189,218,226,192,208,147,239,56,103,103,59,111,
-220,225,40,139,251,181,175,15,114,117,155,195,113,141,166,41,43,230,221,85,44,137,76,132,66,19,203,198,131,0,
-178,73,249,253,81,133,131,152,209,130,117,134,31,38,133,246,84,125,76,136,84,214,244,36,238,36,140,140,202,47,
-100,236,78,199,64,38,211,112,6,180,63,30,232,106,2,0,191,75,186,48,110,206,94,31,239,171,0,127,114,145,
-143,73,173,146,227,149,188,151,155,197,136,212,124,48,47,43,86,6,201,241,1,248,9,136,79,192,84,173,111,137,
-118,62,208,223,133,3,117,190,4,51,236,218,179,233,70,55,147,155,53,132,183,117,110,182,88,34,109,137,109,13,
-176,241,50,90,87,34,140,18,203,229,51,254,115,92,126,203,177,228,84,228,194,112,212,1,111,23,40,202,127,100,
-224,211,158,8,127,16,234,192,9,131,19,140,82,205,51,70,170,235,65,18,88,120,93,73,34,164,16,64,128,68,
-153,28,130,236,81,210,100,43,34,105,118,186,194,136,15,241,155,234,142,164,180,96,152,171,108,228,106,203,175,61,
-196,154,165,56,57,80,86,48,11,183,205,244,114,110,233,165,104,26,42,152,166,51,85,93,9,243,10,99,126,181,
-76,178,69,69,81,45,99,158,67,120,109,145,228,146,162,130,182,156,205,141,63,132,18,127,69,147,101,40,33,115,
-3,155,171,125,85,152,23,238,223,23,57,150,169,247,235,214,195,18,215,58,16,23,194,44,69,191,126,133,44,28,
-151,165,10,196,188,122,146,95,93,179,207,66,194,15,154,183,209,149,221,70,174,234,72,143,214,201,42,63,175,85,
-86,137,115,100,145,43,115,99,102,124,127,31,211,25,66,255,238,168,62,203,2,238,214,218,135,105,93,57,55,167,
-33,92,181,111,114,181,145,171,55,56,16,143,156,3,241,93,141,165,229,236,144,246,195,129,95,203,227,96,68,131,
-112,59,40,206,199,113,31,45,208,0,113,244,122,188,223,159,226,135,201,21,182,223,249,90,23,220,166,161,126,12,
-40,63,206,103,89,73,140,139,23,249,90,250,157,65,220,117,59,60,231,43,95,173,87,90,4,130,222,43,164,182,
-236,15,57,255,190,194,83,161,186,9,62,24,136,22,46,225,143,247,165,196,15,103,160,251,207,117,20,237,16,213,
-209,116,241,186,198,81,150,155,11,175,143,111,159,141,55,31,126,17,245,118,88,77,71,182,204,219,39,208,16,175,
-172,160,135,45,53,204,203,40,102,232,173,126,75,103,235,231,118,117,108,231,193,151,118,208,43,238,245,25,97,86,
-118,115,235,80,95,238,43,239,22,88,1,17,81,213,58,131,159,222,244,236,12,224,15,249,100,240,142,49,63,73,
-162,109,175,4,58,42,135,149,182,120,114,20,53,14,68,174,121,133,79,20,54,27,156,171,70,17,206,176,249,130,
-147,251,122,227,74,51,177,85,84,84,237,26,220,154,224,126,174,140,21,227,156,72,109,5,47,241,163,25,239,152,
-157,60,214,111,220,176,74,41,128,9,67,118,68,215,48,203,144,49,233,48,100,130,2,106,50,152,148,21,43,88,
-49,41,24,178,137,10,144,178,67,42,136,195,185,38,14,19,25,162,37,7,146,17,56,66,181,204,170,42,221,157,
-46,75,119,36,85,6,151,105,84,112,240,120,251,3,17,153,70,2,115,242,17,162,176,23,88,1,9,114,159,42,
-15,133,237,101,163,67,193,43,127,138,1,130,67,119,233,55,94,150,168,186,11,143,236,251,45,205,110,184,139,17,
-239,215,208,103,86,188,91,115,227,221,106,200,159,169,152,183,79,22,244,62,220,129,243,43,72,194,230,38,23,5,
-223,44,211,182,111,47,215,1,62,4,165,213,42,13,231,46,146,130,130,14,106,107,145,185,86,31,250,161,237,149,
-79,124,88,103,212,145,10,179,200,186,151,22,244,209,241,97,165,27,176,12,17,105,235,40,203,105,159,129,56,128,
-190,32,249,145,27,234,245,194,185,165,38,3,186,75,137,177,77,236,120,107,101,187,21,16,230,228,95,220,57,246,
-27,42,88,153,79,191,124,146,1,39,103,54,86,148,14,170,25,122,99,56,94,161,255,215,116,130,123,159,78,195,
-248,106,4,67,167,247,59,92,87,67,169,198,14,118,82,83,182,162,136,56,212,208,162,153,169,236,75,119,159,212,
-246,93,124,17,73,54,141,195,130,49,181,98,158,22,208,100,52,15,255,215,37,40,211,171,230,98,33,237,71,107,
-254,12,190,158,185,165,32,246,187,89,188,21,40,101,241,109,191,192,73,176,150,114,190,174,161,78,58,205,213,174,
-86,39,81,101,180,249,65,30,201,216,110,58,253,245,235,133,91,0,5,17,250,21,158,56,52,239,23,34,198,11,
-3,12,229,159,205,255,31,164,145,158,2,71,127,0,0
+31,139,8,0,0,0,0,0,2,3,188,125,217,118,219,72,150,224,115,251,43,32,148,18,14,84,6,67,0,184,
+73,160,32,181,172,180,219,238,242,86,41,151,179,171,217,60,62,32,16,20,97,129,0,13,4,181,145,60,167,127,
+160,207,60,204,188,77,159,233,154,249,138,121,174,79,233,31,152,254,132,57,247,70,96,227,226,76,87,103,151,85,
+73,0,55,182,27,113,151,184,75,0,117,122,240,195,187,203,15,127,124,255,92,155,138,89,124,246,228,20,46,90,
+236,39,215,158,206,19,29,0,220,15,207,158,252,205,233,140,11,95,11,166,126,150,115,225,61,93,136,73,235,248,
+105,9,79,252,25,247,158,222,70,252,110,158,102,226,169,22,164,137,224,137,240,158,222,69,161,152,122,33,191,141,
+2,222,194,7,26,37,145,136,252,184,149,7,126,204,61,27,59,201,197,67,204,207,158,104,154,166,253,150,254,214,
+245,39,130,103,244,183,238,152,79,210,140,47,199,233,125,43,143,30,163,228,218,141,146,41,207,34,177,6,52,235,
+240,113,154,133,60,107,141,211,251,193,36,77,4,128,185,219,115,88,247,187,245,56,13,31,150,65,26,167,153,251,
+27,199,114,218,78,95,86,153,248,179,40,126,112,245,31,211,113,42,82,157,106,250,75,30,223,114,17,5,190,246,
+150,47,120,3,2,15,23,89,228,199,58,213,114,63,201,91,57,207,162,73,109,44,155,245,248,76,62,223,241,232,
+122,42,220,182,101,13,98,46,4,207,90,249,220,15,0,75,139,89,54,159,13,226,40,225,173,169,172,101,179,222,
+154,141,23,66,164,9,85,151,40,153,47,196,80,60,204,185,151,47,198,179,72,140,150,99,63,184,185,206,210,69,
+18,182,212,76,218,221,182,223,177,7,114,222,174,197,236,140,207,180,60,141,163,80,107,150,181,50,63,140,22,185,
+107,177,78,198,103,3,213,124,50,153,12,130,69,150,167,153,59,79,163,68,240,108,16,70,249,60,246,31,220,40,
+65,252,198,113,26,220,52,38,8,67,52,102,216,183,172,129,154,70,155,29,67,233,214,124,177,77,125,190,170,226,
+220,15,67,172,161,181,225,81,240,123,209,242,227,232,58,113,3,142,216,32,36,228,65,154,249,34,74,19,55,73,
+19,46,129,34,243,147,124,146,102,51,119,49,159,243,44,240,115,62,184,155,70,130,227,176,220,77,210,187,204,159,
+15,102,126,118,29,37,173,113,42,68,58,115,1,143,98,157,221,73,26,44,114,90,60,77,211,91,158,209,70,81,
+163,100,155,28,170,214,142,2,108,177,131,90,138,239,20,69,154,192,26,69,210,133,128,181,114,173,2,213,97,24,
+229,254,56,230,225,136,110,1,182,135,175,10,151,138,182,33,159,248,139,88,12,82,32,136,120,112,45,214,93,215,
+218,205,253,60,191,75,179,102,103,176,200,163,101,235,142,143,111,34,209,242,231,115,238,103,126,130,11,155,240,193,
+214,220,144,28,115,63,227,137,216,205,141,161,13,127,187,185,17,37,120,234,135,233,157,234,125,75,210,7,123,248,
+134,245,96,8,28,199,98,125,40,66,237,226,218,150,245,221,206,41,110,19,13,39,42,193,203,38,101,148,0,85,
+228,192,86,203,13,150,98,93,96,170,90,135,193,148,7,55,227,244,126,180,108,202,210,58,246,199,60,46,129,219,
+146,213,219,37,89,205,209,44,57,154,191,108,162,184,75,76,214,32,28,116,190,129,174,35,59,40,193,34,157,187,
+214,58,23,89,154,92,47,235,99,143,211,56,92,79,29,58,237,45,127,70,157,181,148,124,111,12,84,3,201,65,
+166,206,178,154,109,91,206,182,169,3,157,238,186,24,174,190,36,155,234,100,163,85,103,29,205,174,151,51,255,190,
+85,163,61,131,189,199,143,18,158,169,153,186,150,230,47,68,58,168,213,179,157,166,14,146,143,105,30,225,26,102,
+60,246,69,116,203,235,28,197,178,244,174,36,224,36,230,247,3,248,105,133,81,198,3,108,20,164,241,98,150,84,
+125,110,54,214,152,172,177,201,5,49,191,119,109,205,46,80,196,85,139,249,68,184,214,160,57,177,122,135,127,59,
+227,97,228,147,89,148,168,10,90,199,202,248,204,92,34,154,27,152,101,233,93,163,227,150,93,73,75,224,199,1,
+129,46,181,239,113,17,204,38,174,77,194,22,18,89,173,27,106,213,53,67,38,156,45,4,15,11,238,236,57,189,
+126,223,210,14,162,25,216,3,126,34,84,37,169,220,151,91,234,126,205,238,90,182,101,45,235,139,54,69,72,65,
+108,4,133,45,152,91,131,14,141,49,112,230,18,247,124,185,147,64,170,78,150,222,229,59,214,105,205,102,227,150,
+179,220,230,231,53,155,103,45,123,169,102,222,202,36,78,88,112,215,2,210,41,204,225,118,123,214,249,172,206,218,
+206,252,126,205,130,56,10,110,64,87,3,42,203,114,69,81,157,73,197,168,236,25,37,252,117,133,58,233,76,186,
+147,222,0,21,175,228,216,77,165,172,89,172,155,107,193,98,28,5,173,49,127,140,120,70,44,230,216,93,170,89,
+172,103,195,111,187,219,165,154,109,82,173,210,192,191,184,209,150,42,239,162,97,209,180,38,64,231,182,198,25,247,
+111,92,252,109,1,96,99,222,197,118,89,109,2,217,245,216,39,39,39,84,43,254,179,152,109,106,214,252,94,115,
+230,247,218,177,188,174,55,117,56,221,165,239,203,69,149,138,15,217,187,70,154,193,230,168,142,213,161,154,99,159,
+80,205,105,59,48,176,35,7,110,207,239,181,222,252,94,179,231,247,90,148,228,92,80,77,214,135,197,168,126,44,
+214,145,245,45,85,191,87,212,47,118,69,220,224,106,124,0,21,106,172,130,115,112,139,29,124,219,134,192,65,59,
+125,170,245,218,84,59,70,12,173,174,89,239,124,205,226,244,58,45,180,94,183,216,31,7,147,40,142,221,96,145,
+193,22,125,9,125,173,217,204,143,146,86,93,81,22,154,166,187,185,76,170,55,176,210,80,71,173,89,224,103,97,
+83,21,110,107,206,98,237,237,26,47,43,118,177,155,123,245,22,29,236,206,9,213,236,110,159,106,118,15,215,213,
+238,202,133,69,234,119,230,247,3,80,123,74,45,56,39,22,74,147,159,133,90,77,241,215,135,215,156,154,233,183,
+220,201,186,63,43,73,176,237,248,217,183,163,218,80,5,155,6,220,178,50,202,78,214,108,44,146,86,12,115,218,
+73,121,98,219,109,170,217,142,13,63,39,102,147,143,107,150,203,87,171,2,127,248,97,181,47,74,114,74,152,150,
+223,94,47,253,36,154,161,25,209,2,127,206,205,231,81,50,168,96,225,66,217,24,118,215,178,102,121,173,36,18,
+92,22,181,130,116,145,8,55,74,38,224,228,241,90,21,17,205,64,113,78,22,137,84,182,114,69,215,127,123,195,
+31,38,153,63,227,185,6,163,45,39,89,58,91,86,6,126,150,10,95,112,98,133,252,218,92,139,116,187,164,221,
+147,101,106,253,182,166,183,131,53,193,36,105,29,3,215,84,77,104,237,222,85,94,103,19,134,30,169,82,242,199,
+243,251,194,42,133,219,38,75,117,173,239,170,105,187,97,42,114,205,206,53,238,231,28,84,68,174,249,177,224,89,
+226,11,174,21,171,180,254,133,131,43,159,218,213,245,106,86,254,56,79,227,197,238,62,150,106,183,7,145,169,81,
+145,131,216,90,204,201,215,59,198,144,27,219,190,54,189,188,78,48,152,155,36,88,77,46,44,228,125,75,131,21,
+214,192,167,1,178,237,40,199,162,245,19,198,179,44,69,183,157,229,183,60,22,188,101,139,105,255,161,91,151,2,
+247,55,147,144,159,240,147,194,81,26,91,150,229,88,133,226,3,181,92,236,139,221,192,9,156,154,139,208,175,116,
+96,147,72,82,236,107,54,106,3,160,54,93,105,47,63,121,242,55,167,71,42,60,113,122,36,131,33,167,16,82,
+56,123,114,26,70,183,90,20,122,186,63,159,235,103,167,71,97,116,123,246,228,52,15,178,104,46,206,158,248,97,
+248,252,150,39,226,117,148,11,158,240,140,60,253,225,221,155,75,73,195,215,176,232,225,83,170,17,83,243,206,180,
+229,147,91,63,211,252,249,220,43,228,131,152,75,125,145,115,45,23,89,20,8,125,80,192,53,65,204,229,186,124,
+226,68,152,203,140,139,69,134,37,85,1,116,160,224,239,198,159,121,32,88,144,113,16,152,100,17,199,181,122,57,
+116,32,216,36,205,158,251,193,148,240,90,81,80,245,173,23,64,221,243,96,147,77,39,154,168,42,166,68,80,94,
+161,113,224,137,115,238,121,220,21,7,158,199,87,43,97,24,122,138,56,212,90,175,86,95,239,51,150,125,10,6,
+238,103,18,94,78,163,56,108,96,23,65,5,154,64,21,216,100,51,241,12,121,158,112,154,172,86,27,147,244,229,
+36,165,143,250,54,13,57,203,248,44,189,229,178,87,81,171,153,213,214,51,76,131,197,140,39,197,202,61,143,57,
+60,53,170,47,126,182,250,219,43,162,79,133,152,187,71,71,119,119,119,236,174,205,210,236,250,200,177,44,235,40,
+191,189,214,105,189,183,112,127,111,31,248,61,34,222,24,125,86,209,56,36,186,166,215,138,38,141,162,122,201,92,
+174,27,205,43,130,177,45,78,149,21,40,49,189,51,161,214,106,87,133,170,215,219,130,26,176,242,158,151,156,23,
+205,46,132,200,162,241,66,112,194,77,87,176,107,46,234,144,3,207,75,12,67,176,188,1,166,73,173,231,169,100,
+4,238,233,250,247,156,10,118,55,77,99,92,14,96,46,195,32,130,133,190,240,189,58,107,92,23,188,115,235,199,
+11,238,73,148,248,185,174,187,188,170,116,87,173,131,172,128,72,163,156,43,212,223,103,233,156,103,226,65,98,46,
+75,114,46,42,48,180,62,215,203,221,85,119,97,161,99,46,180,113,37,174,135,64,211,177,87,227,236,123,98,46,
+163,9,57,24,155,98,10,174,86,194,239,180,231,160,4,137,254,162,20,61,63,142,121,168,165,11,145,71,33,215,
+130,116,54,79,19,158,8,77,133,78,163,71,212,203,186,57,80,52,28,87,253,63,192,136,247,196,100,135,135,44,
+77,62,205,96,67,102,243,69,62,109,240,206,39,98,194,126,146,11,77,120,247,164,232,7,231,180,12,32,216,19,
+131,141,226,230,222,129,189,246,150,107,211,59,83,213,3,79,64,207,128,33,104,232,124,200,71,131,104,66,130,162,
+187,180,82,97,176,192,203,241,98,60,142,121,238,38,222,129,77,119,245,92,246,187,41,64,192,112,68,191,92,228,
+34,157,225,67,53,221,128,193,66,212,138,136,0,98,80,110,210,96,189,61,137,117,173,97,30,71,1,39,102,169,
+241,8,247,206,150,28,231,67,4,77,205,181,105,210,131,148,169,184,217,251,140,67,247,60,92,203,14,14,172,245,
+90,226,123,229,13,71,244,6,126,46,225,231,13,252,60,247,222,103,233,44,202,129,131,242,52,190,229,196,132,8,
+134,246,222,59,176,43,150,248,0,4,186,44,73,34,187,123,237,1,31,92,113,129,13,222,122,86,85,255,89,141,
+84,227,65,152,46,39,105,70,6,111,79,175,88,204,147,107,49,29,84,197,87,195,183,163,193,219,239,191,167,192,
+118,244,37,1,82,153,16,13,34,135,82,241,211,162,145,103,81,24,228,166,236,227,134,205,211,57,49,137,57,128,
+234,128,132,240,172,129,56,189,44,106,136,239,61,187,24,137,123,151,67,49,26,188,102,83,63,39,220,92,173,200,
+107,80,34,132,155,148,19,211,92,95,150,163,172,239,166,81,204,73,49,172,236,125,240,166,28,246,77,57,44,44,
+18,125,205,130,152,251,25,49,113,6,21,187,190,132,53,139,38,56,137,3,207,19,108,146,249,215,192,44,32,230,
+139,121,8,59,155,73,115,34,152,52,125,62,73,152,57,40,240,21,44,140,50,241,48,80,87,111,216,178,71,180,
+234,6,148,80,113,207,230,68,176,64,220,3,55,9,134,102,145,234,174,100,154,15,102,193,6,143,13,186,93,84,
+84,123,69,204,229,133,183,204,92,139,6,238,112,68,231,238,197,186,154,207,59,40,101,217,106,149,147,11,22,152,
+244,194,187,96,243,170,248,133,210,96,128,86,100,24,228,145,133,60,230,2,212,63,21,44,34,220,172,173,205,199,
+74,147,69,19,130,109,82,188,125,68,242,8,211,148,188,59,120,68,26,9,147,94,176,64,178,31,1,13,191,172,
+247,158,27,6,65,149,28,18,27,22,212,68,129,16,44,133,205,151,199,96,145,24,70,94,183,52,62,227,230,10,
+77,130,58,248,11,138,100,74,99,197,51,203,98,121,221,136,22,106,201,245,225,54,228,16,131,124,112,51,90,95,
+107,119,177,70,77,51,136,12,35,98,51,146,208,212,164,241,106,245,65,33,45,151,63,241,124,54,243,231,132,155,
+108,18,129,97,77,2,115,144,157,103,114,122,140,177,196,116,115,146,192,12,106,234,208,27,142,96,86,139,58,61,
+75,196,127,146,107,95,244,143,56,40,182,75,106,252,66,114,146,176,10,123,147,214,11,171,123,134,66,81,175,89,
+235,5,183,38,154,0,179,121,195,81,13,135,31,36,14,45,219,243,164,186,69,166,29,90,35,195,32,87,133,230,
+160,239,87,43,242,222,59,176,232,115,38,166,60,33,207,76,53,79,172,13,11,18,19,171,1,27,242,163,182,189,
+178,70,43,207,62,61,229,223,181,237,106,200,31,9,167,1,208,139,70,52,163,11,26,162,136,20,235,48,243,198,
+131,67,82,202,211,196,227,236,240,208,171,104,138,19,9,196,189,188,153,103,233,60,119,51,170,40,41,104,146,138,
+79,252,203,194,143,221,136,142,209,164,79,136,89,177,193,112,84,231,3,245,20,229,65,154,36,60,192,226,134,84,
+3,160,193,42,195,17,69,223,232,94,184,32,141,111,252,57,9,152,130,172,86,100,118,62,195,45,75,85,25,142,
+76,147,150,251,23,98,130,139,227,134,52,191,137,230,159,36,130,7,54,205,210,84,184,1,19,126,118,205,197,106,
+133,157,0,108,61,88,24,198,130,76,240,65,106,248,57,104,248,104,66,38,72,203,244,60,133,213,100,184,14,171,
+213,114,77,9,74,3,99,44,175,239,164,185,82,131,231,249,208,26,185,73,177,73,97,39,134,17,201,222,134,98,
+68,139,27,47,48,13,131,28,76,88,133,168,97,76,24,222,12,197,168,126,79,2,147,206,13,227,7,194,169,48,
+77,154,172,77,19,214,105,82,105,203,57,176,78,78,38,27,42,147,78,42,254,60,56,136,13,35,150,120,152,180,
+88,10,84,46,1,155,62,132,25,52,40,119,159,106,227,47,109,203,139,44,243,31,24,248,136,160,83,193,220,6,
+43,54,55,215,164,236,108,48,169,9,78,117,207,98,169,236,10,17,245,149,250,217,83,59,32,230,0,172,2,145,
+165,134,241,130,0,123,86,123,4,253,130,228,144,3,210,128,249,73,48,77,51,26,176,64,90,16,210,84,55,233,
+51,98,174,15,201,204,92,7,177,159,231,218,223,47,15,21,79,18,115,249,19,17,211,40,167,182,73,225,202,138,
+18,79,172,15,165,169,83,83,25,88,161,110,35,137,209,106,69,118,129,65,236,11,178,39,82,176,185,180,187,203,
+85,77,88,148,132,252,254,221,4,196,175,101,195,238,7,10,38,159,163,33,35,168,109,174,215,135,57,7,199,100,
+9,94,36,31,168,129,114,14,106,138,123,130,90,7,158,167,188,192,27,254,0,59,118,177,29,131,1,173,208,170,
+88,10,248,162,234,3,201,176,163,14,140,91,106,143,63,192,232,32,8,92,205,102,25,16,48,218,51,162,135,209,
+173,110,82,206,162,36,225,217,203,15,111,94,123,79,209,111,198,53,246,116,48,129,49,208,175,159,213,193,50,88,
+223,132,101,233,157,126,118,17,136,232,214,23,81,114,173,93,188,215,102,224,204,49,38,93,111,237,159,18,13,255,
+109,53,250,99,186,208,238,162,56,214,198,92,203,184,140,248,243,80,19,169,171,157,250,218,52,227,19,175,240,210,
+236,19,135,217,189,99,214,97,246,145,126,182,3,120,122,228,43,87,191,254,251,148,222,18,78,117,28,84,167,122,
+25,137,212,100,198,66,171,39,38,116,115,77,103,160,16,204,101,225,197,174,105,168,182,81,31,54,218,218,202,254,
+177,92,89,154,160,130,14,233,132,78,233,152,30,210,123,250,64,63,209,43,122,67,47,233,27,250,156,190,167,31,
+232,107,250,150,62,163,47,233,163,39,134,206,200,48,254,14,247,123,239,64,12,123,35,195,248,29,60,189,242,196,
+176,59,50,140,223,19,16,190,202,34,105,56,241,195,246,232,252,31,221,127,64,119,230,133,247,14,218,125,244,94,
+64,139,77,250,66,52,78,55,105,82,209,58,168,110,211,218,237,62,14,144,171,162,213,210,67,250,217,233,188,40,
+133,124,140,86,229,151,244,179,75,185,43,104,34,213,126,138,94,68,167,71,243,146,4,161,55,35,38,157,84,99,
+78,171,219,49,220,98,136,93,55,233,61,86,124,52,140,71,80,28,244,1,31,47,12,227,2,31,63,225,227,43,
+195,120,133,143,87,248,120,83,117,117,89,221,190,129,91,25,215,213,77,250,220,91,16,29,220,122,147,190,135,219,
+185,47,166,186,73,63,96,7,175,171,86,111,27,173,62,226,40,183,36,173,216,7,152,22,64,99,170,67,104,68,
+167,58,172,64,1,154,199,126,192,167,105,28,242,76,167,250,213,213,171,31,138,146,40,212,169,158,231,81,8,19,
+102,69,160,217,3,106,202,10,16,18,5,111,18,204,61,157,234,233,100,130,53,51,254,101,17,101,28,37,31,158,
+252,240,93,18,63,120,135,192,55,14,52,157,214,89,27,201,37,47,40,184,48,248,100,27,249,96,179,13,66,147,
+70,69,37,250,80,240,158,234,128,253,27,199,214,108,251,117,143,117,236,142,102,195,61,235,91,125,173,139,191,182,
+197,156,147,182,214,193,95,135,117,143,123,154,237,20,80,251,68,214,145,13,236,99,4,170,126,218,26,116,219,126,
+196,145,158,83,253,126,22,39,128,194,87,66,51,170,38,70,124,117,170,219,189,2,34,35,191,13,16,156,123,122,
+150,222,235,84,183,52,75,115,58,154,211,209,77,122,7,69,96,133,233,84,135,112,103,1,186,229,25,156,40,138,
+101,2,84,167,250,44,10,195,152,99,103,111,74,138,151,252,129,192,98,205,36,84,43,147,5,13,177,49,233,155,
+45,162,95,110,81,78,230,43,53,200,103,98,239,111,203,33,229,41,146,2,184,49,36,230,103,55,134,123,187,53,
+220,235,157,68,191,105,18,189,204,192,98,225,183,169,205,156,250,114,159,203,6,17,201,41,167,190,73,99,140,25,
+209,152,36,52,128,75,128,190,2,9,104,40,47,19,184,76,232,20,46,83,58,54,233,53,25,83,49,180,70,178,
+248,94,169,130,25,9,168,244,146,1,250,160,52,66,19,250,73,41,134,58,148,211,43,121,185,129,203,13,189,132,
+203,37,125,3,151,55,244,57,92,158,211,247,178,236,131,188,188,134,203,107,250,22,164,127,70,222,170,174,158,173,
+86,228,165,55,156,163,40,163,170,162,98,104,219,35,147,206,37,15,68,193,13,128,142,17,194,75,130,81,146,121,
+98,216,31,209,29,22,152,96,115,25,195,248,65,70,52,136,73,51,21,237,0,123,70,128,127,55,162,207,188,3,
+203,92,211,185,220,4,142,13,136,172,109,40,16,147,118,0,124,120,224,121,68,41,6,19,107,85,234,194,164,54,
+84,25,203,192,27,88,42,232,178,84,171,13,141,206,31,207,31,153,28,200,37,143,30,110,80,82,13,75,10,60,
+152,166,251,40,125,94,112,65,31,61,185,54,176,129,157,95,24,6,185,144,240,11,9,119,47,206,47,202,222,46,
+188,223,41,247,22,212,57,246,246,9,252,159,97,119,116,254,234,252,85,89,239,149,247,123,220,8,177,94,141,150,
+166,251,202,48,200,43,57,192,43,53,176,92,140,55,155,139,241,2,214,65,238,140,176,12,31,101,35,185,71,210,
+143,8,129,222,107,228,53,139,190,54,164,102,99,243,151,188,24,22,27,82,88,108,69,33,246,6,191,207,32,82,
+146,147,151,13,59,225,239,54,237,132,133,180,20,246,216,99,155,219,53,30,80,42,54,236,98,155,92,224,198,21,
+2,40,159,251,32,202,33,158,103,80,73,12,79,127,55,231,137,150,112,113,151,102,55,26,73,82,173,72,190,155,
+186,220,208,148,98,41,206,69,161,25,176,169,50,234,251,68,85,175,177,83,236,222,115,248,198,158,83,170,135,175,
+43,134,148,225,48,136,64,111,132,208,69,169,46,38,171,21,153,130,8,194,110,60,245,147,107,142,50,232,160,196,
+53,97,237,145,57,162,147,29,130,147,110,242,74,175,163,224,245,129,55,201,62,145,84,157,54,168,250,187,58,85,
+243,130,174,63,79,211,188,78,198,91,146,151,148,40,8,84,128,155,182,4,24,84,218,251,141,42,104,84,212,218,
+229,91,20,204,247,24,22,88,50,139,18,233,108,232,52,192,137,159,131,52,184,199,208,81,105,119,164,210,66,253,
+75,169,14,116,93,70,36,160,92,106,254,146,234,57,232,250,156,138,97,103,100,210,197,106,69,66,111,142,115,42,
+181,43,22,236,32,98,190,155,136,1,136,125,115,30,134,177,53,207,162,118,10,181,213,220,76,236,180,154,177,73,
+237,30,212,201,107,218,178,131,218,82,225,187,193,31,11,224,143,144,52,216,227,247,27,236,241,11,25,163,144,251,
+144,128,106,84,116,42,22,181,76,200,106,205,132,236,95,46,147,66,82,71,236,162,78,76,114,26,84,107,223,118,
+96,73,166,36,64,165,253,21,183,232,31,246,56,156,33,209,149,131,240,77,94,214,63,254,156,255,218,152,89,149,
+54,255,166,65,132,32,92,142,130,196,242,248,208,30,25,198,31,32,18,230,29,200,135,63,130,147,95,195,32,48,
+140,0,247,145,4,85,113,106,24,41,62,230,222,132,168,161,185,170,37,239,105,132,145,38,174,234,214,128,144,29,
+145,235,60,228,35,115,41,134,246,232,60,88,173,72,224,1,6,114,20,232,37,169,229,73,105,98,154,110,96,24,
+36,144,219,91,80,110,198,246,232,60,149,170,14,224,169,218,140,211,243,180,220,100,83,15,92,87,42,241,5,76,
+242,122,199,185,105,174,105,228,10,154,186,66,46,24,78,2,195,211,184,116,137,154,65,5,201,27,139,9,129,9,
+153,114,148,129,146,220,251,36,179,45,203,49,56,64,110,176,246,56,93,226,109,138,183,233,156,39,110,140,183,254,
+252,19,4,14,220,8,159,102,126,2,145,73,31,19,82,156,102,32,103,11,79,215,105,8,63,51,47,30,248,249,
+67,18,104,141,228,106,66,218,80,211,50,105,66,186,88,83,6,2,5,230,3,94,164,217,236,7,95,248,131,34,
+127,77,116,196,74,167,193,106,165,235,152,87,80,112,9,78,55,193,165,190,5,173,213,44,82,216,235,52,90,173,
+14,236,122,137,156,137,78,125,44,24,136,236,161,204,215,248,119,126,36,180,9,23,193,148,232,71,60,159,171,224,
+234,145,186,234,116,57,227,98,154,134,174,254,254,221,213,7,157,194,9,7,140,166,254,225,199,215,87,220,207,130,
+233,123,63,243,103,144,79,88,203,169,6,158,174,215,198,16,106,12,142,38,2,49,33,28,42,170,132,145,96,34,
+139,102,16,165,243,56,203,133,159,137,252,167,72,76,137,190,212,205,243,191,191,122,247,22,184,35,135,164,48,155,
+241,60,247,175,57,204,219,229,235,117,224,3,210,194,92,170,28,156,230,88,150,231,201,94,196,34,63,207,137,158,
+47,130,128,131,104,46,85,91,55,88,155,174,164,12,172,56,238,107,106,166,72,65,63,138,121,200,180,247,49,158,
+203,185,133,87,57,30,180,135,116,145,105,65,198,67,158,64,146,53,103,160,58,37,157,109,147,242,10,145,34,96,
+39,41,255,86,217,63,168,56,203,62,69,246,160,249,215,126,148,52,123,1,57,89,175,31,8,65,158,194,64,31,
+36,120,38,32,211,92,124,136,102,60,93,8,153,226,184,139,146,48,189,99,113,26,96,178,119,119,132,202,164,54,
+239,96,146,102,80,26,252,24,182,243,132,119,182,84,92,23,37,26,196,12,201,9,236,192,12,97,166,138,19,20,
+69,22,77,61,193,84,9,136,74,89,98,91,52,246,4,3,152,73,75,230,43,75,105,228,1,3,34,212,164,5,
+11,22,197,14,245,61,193,36,208,92,203,76,132,140,51,123,56,119,219,114,142,141,42,63,97,24,196,95,173,18,
+210,3,177,3,13,49,76,105,68,125,153,144,160,51,58,161,181,243,49,57,209,33,140,10,42,56,160,113,189,36,
+149,33,88,220,87,41,206,205,92,215,203,103,178,92,89,99,20,199,3,34,57,96,51,202,25,155,107,25,133,157,
+193,44,58,168,15,154,125,44,154,99,116,232,194,92,143,84,224,56,17,26,191,23,60,9,33,134,140,2,144,45,
+2,145,226,225,146,124,49,231,144,223,252,81,249,95,148,11,42,4,77,169,210,91,39,20,47,22,69,125,101,91,
+180,80,86,54,85,138,202,89,215,35,175,249,150,30,20,69,142,187,224,136,124,216,27,121,124,152,140,104,94,59,
+221,83,109,70,245,13,167,102,42,36,95,15,216,109,198,107,149,231,190,21,178,173,121,251,103,95,15,251,53,194,
+124,111,83,205,71,161,214,240,64,113,174,69,137,150,129,237,189,29,123,173,34,176,201,78,235,131,203,205,57,145,
+27,96,177,223,168,93,166,190,167,164,162,102,79,161,243,74,115,111,56,42,51,226,220,179,6,252,52,41,146,215,
+28,50,226,112,0,194,139,4,201,133,26,162,177,127,55,115,233,121,35,151,14,241,127,204,91,240,106,51,79,170,
+38,114,176,124,107,48,38,235,13,42,123,3,118,220,0,147,50,109,35,144,248,167,136,179,154,67,234,89,131,180,
+66,59,173,37,242,99,79,225,157,154,131,124,152,142,206,225,135,205,73,76,3,211,37,240,0,115,139,77,138,112,
+180,60,224,102,70,120,125,51,199,116,52,228,245,211,10,223,84,226,155,142,208,66,24,20,112,175,64,99,173,236,
+164,131,250,113,145,106,246,137,103,13,146,83,81,244,150,64,111,98,152,140,12,3,126,49,171,186,6,67,89,217,
+6,77,67,43,174,211,177,105,208,149,1,218,164,22,160,69,198,145,193,71,139,218,78,96,181,108,102,91,237,150,
+197,142,79,250,45,7,254,166,45,251,99,63,176,90,14,235,119,251,45,135,57,157,118,171,11,127,87,125,218,129,
+39,218,167,253,219,246,203,94,32,219,82,171,229,80,213,158,58,183,199,129,69,21,28,96,212,129,191,169,237,104,
+129,130,82,167,165,74,90,206,71,219,121,212,222,156,208,62,34,210,235,118,168,205,218,157,94,171,77,219,173,118,
+222,150,79,180,77,219,183,237,151,39,31,251,143,133,121,250,11,131,154,188,10,106,98,152,18,33,101,80,179,2,
+237,11,106,242,50,168,89,63,82,94,8,91,94,88,194,121,97,234,239,55,136,35,177,203,189,157,208,235,159,79,
+111,208,11,250,138,190,67,63,140,229,209,117,226,199,223,235,58,125,33,1,112,120,25,30,63,202,71,84,172,240,
+252,89,62,103,121,30,193,227,23,233,152,225,214,102,24,16,26,27,212,78,1,212,114,33,157,17,145,30,251,183,
+185,87,187,178,32,139,234,118,2,206,202,127,252,219,255,252,87,237,207,127,210,116,147,94,99,156,5,95,199,194,
+124,69,72,222,153,244,16,42,125,135,41,11,56,227,247,231,63,253,251,255,250,31,178,250,131,23,146,23,69,178,
+226,170,234,246,166,209,205,77,51,96,243,12,178,5,174,78,47,177,213,27,47,36,31,33,109,161,186,254,231,255,
+243,231,63,149,73,180,250,63,76,104,212,187,125,223,236,246,199,171,171,87,174,94,38,58,66,242,25,146,28,208,
+107,248,12,146,67,207,176,224,101,133,228,23,195,248,34,99,126,88,114,75,174,42,205,93,237,2,154,122,121,6,
+217,238,10,130,16,242,237,27,56,215,172,83,189,221,157,203,72,81,186,51,232,252,114,79,228,123,51,57,177,29,
+145,206,119,68,164,119,187,191,59,124,94,173,241,134,75,33,22,126,33,22,254,110,15,184,138,90,167,50,26,181,
+144,81,235,5,189,134,203,53,68,173,225,114,40,129,247,242,242,32,27,124,146,23,140,66,95,201,40,244,149,140,
+66,95,201,40,244,149,140,66,95,201,40,244,149,140,66,95,201,40,244,21,68,161,97,244,103,242,242,82,81,103,
+70,94,214,34,220,143,38,189,88,173,200,43,111,46,167,139,145,232,159,48,181,40,67,39,242,44,174,199,169,109,
+36,134,241,14,2,31,155,226,105,130,103,63,166,239,76,89,71,69,80,235,18,139,53,30,232,11,85,227,35,212,
+216,16,98,172,242,134,126,84,85,62,67,149,166,92,99,141,215,244,179,140,25,163,116,159,127,49,12,242,69,250,
+170,95,148,175,250,101,181,34,95,60,12,136,75,86,172,77,121,51,246,130,11,130,33,89,112,14,95,53,131,48,
+126,205,173,175,5,94,235,90,172,210,43,87,27,105,86,107,164,182,184,51,235,28,78,155,8,204,184,222,120,87,
+48,236,165,119,179,17,15,72,190,65,191,44,254,26,246,155,126,246,31,255,246,223,255,55,164,226,223,164,33,223,
+200,195,23,255,118,152,125,74,20,207,246,91,115,91,201,220,201,95,103,62,255,254,175,255,242,255,254,239,127,211,
+158,163,69,42,77,238,248,225,215,156,216,20,39,118,137,60,119,141,247,227,106,146,135,213,237,125,35,75,124,191,
+161,113,249,36,227,249,20,194,236,139,175,170,159,173,220,236,142,10,187,244,231,29,64,27,239,67,128,198,205,248,
+108,151,250,172,178,184,247,187,243,134,88,118,184,83,123,142,183,51,199,201,55,30,164,200,11,3,63,223,78,2,
+42,117,154,202,92,96,42,181,106,10,185,192,75,54,35,105,169,226,18,169,104,19,169,104,199,82,209,30,130,162,
+125,88,173,200,39,72,9,44,74,197,199,135,50,33,48,169,65,218,8,185,175,65,186,144,32,120,168,98,203,24,
+119,187,241,60,143,128,124,99,222,232,242,252,178,12,152,93,74,253,4,66,47,76,122,105,24,68,242,72,13,207,
+173,160,89,17,42,187,68,237,244,32,83,8,159,26,234,41,219,27,40,147,254,213,39,233,95,97,192,108,103,12,
+161,81,173,22,48,128,88,66,163,12,252,245,128,230,232,56,67,80,134,199,50,176,84,120,176,112,184,0,157,91,
+93,167,234,186,54,247,215,182,183,106,75,159,248,160,244,132,15,172,181,73,69,179,185,108,163,162,28,84,61,192,
+246,34,27,203,64,70,53,108,166,228,200,44,124,247,197,183,248,238,153,160,62,250,238,205,165,180,26,30,122,248,
+141,158,246,252,236,52,191,189,214,208,154,247,190,102,204,107,242,219,42,122,175,163,107,210,126,151,247,202,112,247,
+106,118,187,134,175,47,120,104,184,187,191,225,65,167,215,233,193,41,27,95,76,181,208,211,223,216,14,117,46,123,
+172,115,220,67,215,164,184,179,157,188,131,183,182,37,255,151,219,86,171,128,180,108,235,202,238,179,174,221,193,154,
+20,156,22,187,77,237,254,180,229,220,182,122,83,231,163,221,151,160,147,105,203,249,216,159,58,31,79,30,65,49,
+194,168,103,167,48,5,120,104,106,213,211,105,239,236,5,70,231,224,128,79,144,38,147,232,122,145,113,237,66,198,
+2,222,195,2,159,30,77,123,155,238,190,210,14,168,136,54,116,4,189,131,138,82,149,233,50,83,85,0,63,47,
+114,17,77,30,90,234,205,58,208,55,234,104,195,55,70,14,102,155,158,204,96,223,219,81,144,1,191,21,46,70,
+208,231,194,157,200,13,127,225,165,32,244,161,183,216,117,196,170,230,102,204,183,216,229,191,152,87,236,94,208,63,
+241,27,188,114,194,78,122,93,122,204,186,142,125,9,15,199,199,244,152,181,59,125,234,88,244,152,217,253,54,222,
+160,179,220,238,159,180,28,102,119,218,173,14,115,142,143,91,29,104,212,106,67,7,151,118,135,245,129,203,216,177,
+229,80,187,205,58,189,158,98,36,237,234,132,57,192,86,88,132,3,209,14,179,218,221,203,30,179,219,199,180,205,
+250,182,67,59,180,203,122,80,2,99,81,11,7,134,239,235,128,223,13,216,88,208,130,90,136,166,236,233,4,223,
+102,119,168,109,177,110,27,111,28,45,183,176,200,97,253,227,46,117,176,73,155,117,250,39,151,29,236,202,238,178,
+94,183,77,59,112,115,236,244,225,166,23,88,20,103,70,29,196,6,102,214,166,56,51,42,103,166,176,183,153,125,
+114,44,7,235,80,71,78,205,209,114,24,170,215,146,195,226,80,45,28,246,210,238,179,227,46,44,34,246,7,145,
+136,99,57,138,133,99,182,112,134,45,156,97,11,103,216,194,25,182,212,12,213,104,29,57,17,181,162,242,206,209,
+174,84,177,92,129,58,5,65,66,45,118,210,237,82,27,206,74,245,226,86,155,245,122,253,22,172,113,39,182,89,
+199,233,180,108,214,177,58,177,195,28,64,143,57,199,189,184,195,218,78,31,104,122,130,117,172,99,10,53,95,55,
+122,218,148,245,167,52,71,107,7,13,215,105,15,79,19,200,147,111,252,151,202,49,223,37,199,252,231,229,120,103,
+254,177,12,81,4,128,73,121,8,164,204,69,46,96,167,150,130,105,26,70,120,30,150,59,117,40,119,106,41,173,
+52,52,12,34,103,82,235,101,203,133,128,54,13,149,49,217,183,45,132,164,76,41,92,22,250,47,100,218,135,236,
+1,14,189,74,173,8,137,140,50,213,0,105,23,198,152,246,106,162,137,41,223,204,115,228,20,161,248,146,90,44,
+79,193,102,28,19,48,236,155,213,220,252,43,56,23,184,250,50,44,237,223,242,80,187,139,196,52,93,8,237,214,
+143,163,16,11,152,246,97,202,53,249,57,48,137,12,36,74,234,147,122,53,209,32,83,245,43,99,126,43,246,38,
+140,241,36,211,142,52,238,92,2,58,224,102,78,225,24,189,172,183,47,152,53,109,102,119,247,111,0,214,232,124,
+38,220,176,82,252,92,178,210,94,79,111,119,80,169,16,158,173,99,150,141,144,122,101,153,231,251,76,246,111,181,
+182,107,107,190,17,195,216,146,34,180,120,255,211,114,180,211,226,221,146,167,235,210,206,5,219,86,101,4,221,188,
+158,226,13,84,138,183,204,18,166,158,174,239,51,123,139,156,98,101,240,98,106,69,66,183,51,93,54,218,195,42,
+211,69,117,53,66,45,17,6,249,53,5,5,67,25,163,157,133,209,121,247,45,70,231,181,160,83,52,58,139,57,
+90,133,61,108,211,98,98,205,28,209,120,71,60,92,227,152,169,190,19,100,41,95,215,41,187,195,160,132,18,199,
+43,76,177,22,179,46,198,217,81,67,150,148,227,239,170,33,139,214,107,147,34,131,127,222,120,73,163,116,229,224,
+101,13,184,161,137,119,96,149,98,88,56,47,203,245,0,3,63,164,196,202,219,143,176,10,18,145,2,63,111,47,
+230,181,154,18,79,111,255,20,224,109,6,124,51,2,60,158,8,150,54,89,173,200,198,75,39,144,154,72,164,239,
+7,156,191,252,184,179,216,86,250,228,39,124,77,167,206,206,135,91,22,101,241,126,237,240,147,160,15,98,68,99,
+76,77,213,222,92,223,12,44,73,159,8,148,174,188,227,225,185,237,90,235,146,254,192,94,52,241,98,200,96,165,
+67,62,130,71,169,123,54,207,152,128,80,85,169,39,117,156,36,1,117,84,80,72,229,157,34,143,15,84,199,220,
+243,188,232,28,155,201,10,46,121,5,71,24,73,60,140,70,212,166,54,149,47,242,193,35,134,228,224,149,188,119,
+164,192,136,38,231,73,217,112,3,73,196,207,164,47,72,2,239,227,36,187,207,150,224,225,3,164,139,66,180,162,
+132,4,20,107,143,40,238,59,102,114,255,151,167,73,191,250,102,75,67,73,215,141,158,102,101,117,202,232,91,61,
+194,118,175,178,242,225,254,231,172,124,173,145,201,217,240,11,157,160,203,58,142,77,193,255,3,3,190,127,34,157,
+191,105,203,9,44,218,97,237,118,31,109,198,54,61,110,29,211,227,188,117,44,31,91,199,45,112,2,160,66,143,
+42,8,84,249,8,158,38,244,34,61,205,238,177,52,196,47,29,106,247,113,32,85,170,12,230,109,151,241,103,50,
+191,181,144,253,30,35,97,215,134,82,39,250,195,126,125,153,84,250,82,69,26,154,146,86,15,59,108,200,32,20,
+20,193,141,141,50,5,86,33,138,102,25,192,26,138,183,42,146,80,208,168,156,193,91,104,242,60,4,149,231,21,
+21,168,60,26,3,30,103,9,197,179,42,186,52,105,126,45,117,140,83,247,118,173,71,165,92,119,85,105,214,80,
+75,225,237,94,161,170,30,44,139,183,99,169,118,171,252,205,53,251,171,168,240,79,251,217,104,81,177,81,51,116,
+132,216,54,64,53,242,22,193,42,121,56,178,164,176,10,125,201,67,174,191,18,49,27,40,120,219,88,253,85,22,
+240,106,103,126,24,178,43,115,181,27,78,189,225,189,160,135,130,142,197,136,94,55,54,196,187,29,153,150,212,135,
+252,225,185,181,211,198,225,137,56,119,92,187,216,31,67,239,14,246,132,137,119,61,12,71,222,116,24,86,251,227,
+238,220,111,242,77,47,184,77,29,252,114,144,136,68,204,75,101,92,124,84,77,195,79,197,233,103,151,254,28,62,
+89,165,189,71,23,232,244,104,234,64,180,236,159,4,252,157,70,179,107,236,2,190,249,166,107,121,22,120,250,145,
+188,247,99,225,233,175,241,54,77,80,212,61,189,252,186,198,53,23,234,133,215,103,15,175,66,98,252,166,125,50,
+128,102,120,99,170,111,159,16,115,240,213,6,136,182,106,33,191,140,162,80,215,60,13,193,248,113,75,188,27,232,
+71,53,164,247,191,215,167,156,89,201,205,154,143,47,247,149,239,22,84,14,162,38,82,170,165,153,22,76,211,52,
+231,154,241,101,145,138,129,74,63,201,7,86,127,37,176,22,114,248,106,46,94,57,83,201,118,50,162,150,94,129,
+175,204,125,37,225,188,145,20,129,25,238,127,193,169,249,1,190,175,166,137,235,129,138,102,94,3,88,147,205,200,
+66,101,49,230,165,80,163,227,37,207,209,132,3,197,201,33,126,227,6,155,148,47,194,160,65,118,13,71,195,42,
+131,12,30,27,6,153,20,1,58,57,159,148,13,55,164,98,82,24,100,19,48,200,38,21,74,133,114,152,163,114,
+152,72,20,43,117,32,1,246,70,168,4,81,220,240,238,110,234,222,29,168,42,37,203,144,84,104,200,177,187,4,
+65,134,36,65,225,207,28,148,254,209,65,229,32,233,250,154,150,155,130,91,79,58,20,182,242,47,74,64,216,107,
+218,212,223,195,209,122,243,184,112,80,251,126,203,222,99,184,121,0,239,215,192,153,89,121,186,85,168,211,173,74,
+253,169,134,130,125,206,225,244,225,128,179,60,205,224,156,40,144,195,59,227,152,251,110,9,188,192,219,254,224,173,
+110,232,112,228,34,89,160,214,14,179,69,234,181,122,199,114,106,163,26,70,237,48,106,64,29,222,174,142,151,22,
+250,177,113,134,21,142,1,171,243,170,213,164,174,2,63,49,140,157,224,226,195,7,100,119,233,55,79,110,103,55,
+123,38,108,186,114,49,225,115,37,229,145,94,32,80,26,115,248,128,38,156,112,6,214,31,230,141,247,233,100,79,
+219,123,6,126,69,161,24,104,167,23,250,149,26,202,70,201,183,12,148,189,13,10,239,20,191,209,194,133,31,197,
+213,93,81,122,190,9,64,22,110,158,95,253,207,76,199,254,213,167,179,15,191,109,23,182,49,250,150,125,184,167,
+84,154,166,56,200,86,217,87,138,208,198,220,221,163,154,169,148,160,29,124,178,57,118,73,17,229,32,236,193,163,
+172,182,175,86,105,30,23,21,11,215,97,47,250,7,101,85,244,36,190,50,151,170,230,38,209,118,145,193,194,153,
+55,117,93,73,183,82,224,144,153,42,121,27,21,218,3,140,96,25,251,250,229,129,175,27,65,175,48,240,5,193,
+45,178,148,159,243,112,247,217,41,248,81,70,115,109,174,137,57,120,242,100,109,14,158,156,30,21,159,102,60,61,
+82,31,112,60,146,255,167,23,255,31,0,0,255,255
 };
 
 #endif
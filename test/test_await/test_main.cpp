@@ -0,0 +1,222 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) Mathieu Carbou
+ */
+#include <MycilaESPConnectAwait.h>
+#include <unity.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// same state machine interface as Mycila::ESPConnect
+class FakeConnect {
+  public:
+    enum class State {
+      NETWORK_DISABLED = 0,
+      NETWORK_CONNECTING,
+      NETWORK_CONNECTED,
+      NETWORK_DISCONNECTED,
+      NETWORK_READY,
+    };
+
+    typedef struct {
+        State previous;
+        State state;
+    } Event;
+
+    typedef std::function<void(const Event& event)> EventCallback;
+
+    static constexpr uint32_t stateMask(State state) { return 1UL << static_cast<uint32_t>(state); }
+
+    State getState() const { return _state; }
+
+    uint16_t subscribe(EventCallback callback, uint32_t mask, bool sync) {
+      (void)sync;
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_subscribers.size() >= maxSubscribers)
+        return 0;
+      _subscribers.push_back({++_lastId, mask, std::move(callback)});
+      return _lastId;
+    }
+
+    void unsubscribe(uint16_t id) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      for (size_t i = 0; i < _subscribers.size(); i++) {
+        if (_subscribers[i].id == id) {
+          _subscribers.erase(_subscribers.begin() + i);
+          return;
+        }
+      }
+    }
+
+    void setState(State state) {
+      const Event event = {_state, state};
+      _state = state;
+      std::vector<Subscriber> subscribers;
+      {
+        // copy: a subscriber can unsubscribe while being called
+        std::lock_guard<std::mutex> lock(_mutex);
+        subscribers = _subscribers;
+      }
+      for (const Subscriber& subscriber : subscribers)
+        if (subscriber.mask & stateMask(state))
+          subscriber.callback(event);
+    }
+
+    size_t subscribers() {
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _subscribers.size();
+    }
+
+    size_t maxSubscribers = 8;
+
+  private:
+    typedef struct {
+        uint16_t id;
+        uint32_t mask;
+        EventCallback callback;
+    } Subscriber;
+
+    std::atomic<State> _state{State::NETWORK_CONNECTING};
+    std::mutex _mutex;
+    std::vector<Subscriber> _subscribers;
+    uint16_t _lastId = 0;
+};
+
+typedef Mycila::Await::StateResult<FakeConnect::State> Result;
+
+static FakeConnect* connect;
+static Mycila::Await::Executor* executor;
+static std::atomic<bool> resumed;
+static Result result;
+
+static Mycila::Await::Task waitConnected(uint32_t timeoutMs) {
+  result = co_await Mycila::Await::connected(*connect, timeoutMs);
+  resumed = true;
+}
+
+void setUp() {
+  connect = new FakeConnect();
+  executor = new Mycila::Await::Executor();
+  resumed = false;
+  result = {false, FakeConnect::State::NETWORK_DISABLED};
+}
+
+void tearDown() {
+  delete executor;
+  delete connect;
+}
+
+void test_ready_without_suspending() {
+  connect->setState(FakeConnect::State::NETWORK_CONNECTED);
+  executor->spawn(waitConnected(0));
+  executor->runOnce();
+  TEST_ASSERT_TRUE(resumed);
+  TEST_ASSERT_TRUE(static_cast<bool>(result));
+  TEST_ASSERT_EQUAL(0, connect->subscribers());
+}
+
+void test_resumed_on_transition() {
+  executor->spawn(waitConnected(0));
+  executor->runOnce();
+  TEST_ASSERT_FALSE(resumed);
+  TEST_ASSERT_EQUAL(1, connect->subscribers());
+
+  // not in the mask
+  connect->setState(FakeConnect::State::NETWORK_DISCONNECTED);
+  executor->runOnce();
+  TEST_ASSERT_FALSE(resumed);
+
+  connect->setState(FakeConnect::State::NETWORK_CONNECTED);
+  executor->runOnce();
+  TEST_ASSERT_TRUE(resumed);
+  TEST_ASSERT_TRUE(static_cast<bool>(result));
+  TEST_ASSERT_TRUE(result.state == FakeConnect::State::NETWORK_CONNECTED);
+  TEST_ASSERT_EQUAL(0, connect->subscribers());
+}
+
+void test_connected_when_ready() {
+  // readiness checks passed: the network is still up
+  connect->setState(FakeConnect::State::NETWORK_READY);
+  executor->spawn(waitConnected(0));
+  executor->runOnce();
+  TEST_ASSERT_TRUE(resumed);
+  TEST_ASSERT_TRUE(static_cast<bool>(result));
+  TEST_ASSERT_TRUE(result.state == FakeConnect::State::NETWORK_READY);
+  TEST_ASSERT_EQUAL(0, connect->subscribers());
+
+  // waiting from NETWORK_CONNECTING and resumed on NETWORK_READY
+  resumed = false;
+  connect->setState(FakeConnect::State::NETWORK_CONNECTING);
+  executor->spawn(waitConnected(0));
+  executor->runOnce();
+  TEST_ASSERT_FALSE(resumed);
+  connect->setState(FakeConnect::State::NETWORK_READY);
+  executor->runOnce();
+  TEST_ASSERT_TRUE(resumed);
+  TEST_ASSERT_TRUE(result.state == FakeConnect::State::NETWORK_READY);
+  TEST_ASSERT_EQUAL(0, connect->subscribers());
+}
+
+void test_timeout() {
+  executor->spawn(waitConnected(20));
+  const auto start = std::chrono::steady_clock::now();
+  while (!resumed && std::chrono::steady_clock::now() - start < std::chrono::seconds(1)) {
+    executor->runOnce();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  TEST_ASSERT_TRUE(resumed);
+  TEST_ASSERT_FALSE(static_cast<bool>(result));
+  TEST_ASSERT_TRUE(result.timeout);
+  TEST_ASSERT_TRUE(result.state == FakeConnect::State::NETWORK_CONNECTING);
+  TEST_ASSERT_EQUAL(0, connect->subscribers());
+
+  // a late transition does not resume the coroutine again
+  connect->setState(FakeConnect::State::NETWORK_CONNECTED);
+  executor->runOnce();
+}
+
+void test_subscribers_full() {
+  connect->maxSubscribers = 0;
+  executor->spawn(waitConnected(0));
+  executor->runOnce();
+  // resumed at once: no subscription and no timeout would ever resume it
+  TEST_ASSERT_TRUE(resumed);
+  TEST_ASSERT_FALSE(static_cast<bool>(result));
+  TEST_ASSERT_TRUE(result.state == FakeConnect::State::NETWORK_CONNECTING);
+}
+
+void test_run_from_another_thread() {
+  executor->spawn(waitConnected(0));
+  std::thread runner([]() { executor->run(); });
+
+  while (connect->subscribers() == 0)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  // the state changes in another thread than the executor, like from the WiFi event task
+  connect->setState(FakeConnect::State::NETWORK_CONNECTED);
+  const auto start = std::chrono::steady_clock::now();
+  while (!resumed && std::chrono::steady_clock::now() - start < std::chrono::seconds(1))
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  executor->stop();
+  runner.join();
+  TEST_ASSERT_TRUE(resumed);
+  TEST_ASSERT_TRUE(static_cast<bool>(result));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_ready_without_suspending);
+  RUN_TEST(test_resumed_on_transition);
+  RUN_TEST(test_connected_when_ready);
+  RUN_TEST(test_timeout);
+  RUN_TEST(test_subscribers_full);
+  RUN_TEST(test_run_from_another_thread);
+  return UNITY_END();
+}
@@ -0,0 +1,323 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) Mathieu Carbou
+ */
+#include <MycilaESPConnectImprov.h>
+#include <unity.h>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Mycila::Improv::Device on the device side of a pseudo-terminal, with the callbacks of ESPConnect replaced by this state
+typedef struct {
+    // the captive portal is started and no credential test is pending: the credentials can be tested
+    bool portalStarted;
+    bool testPending;
+    // credentials received, as "ssid/password"
+    std::vector<std::string> received;
+} FakeESPConnect;
+
+typedef struct {
+    Mycila::Improv::Type type;
+    std::vector<uint8_t> data;
+} Packet;
+
+static int client = -1;
+static int device = -1;
+static FakeESPConnect espConnect;
+static Mycila::Improv::Device* improv;
+
+// Device side: feeds the bytes received on the serial port to the device, like ESPConnect::_improvLoop() from loop()
+static void loopDevice() {
+  struct pollfd pfd = {device, POLLIN, 0};
+  while (poll(&pfd, 1, 20) > 0) {
+    uint8_t buffer[64];
+    const ssize_t n = read(device, buffer, sizeof(buffer));
+    for (ssize_t i = 0; i < n; i++)
+      improv->feed(buffer[i]);
+  }
+}
+
+// Client side: reads the packets sent by the device until count are received or the timeout expires
+static std::vector<Packet> receive(size_t count, int timeoutMs = 1000) {
+  loopDevice();
+  std::vector<Packet> packets;
+  Mycila::Improv::Parser parser;
+  while (packets.size() < count) {
+    struct pollfd pfd = {client, POLLIN, 0};
+    if (poll(&pfd, 1, timeoutMs) <= 0)
+      break;
+    uint8_t buffer[64];
+    const ssize_t n = read(client, buffer, sizeof(buffer));
+    for (ssize_t i = 0; i < n; i++)
+      if (parser.feed(buffer[i]) == Mycila::Improv::Parser::Result::PACKET)
+        packets.push_back({parser.type(), std::vector<uint8_t>(parser.data(), parser.data() + parser.length())});
+  }
+  return packets;
+}
+
+static void send(const void* data, size_t length) {
+  TEST_ASSERT_EQUAL(static_cast<ssize_t>(length), write(client, data, length));
+}
+
+static void sendRPC(const std::vector<uint8_t>& data) {
+  uint8_t packet[10 + ESPCONNECT_IMPROV_MAX_DATA];
+  const size_t size = Mycila::Improv::encode(packet, sizeof(packet), Mycila::Improv::Type::RPC, data.data(), data.size());
+  TEST_ASSERT_NOT_EQUAL(0, size);
+  send(packet, size);
+}
+
+static std::vector<uint8_t> wifiSettings(const char* ssid, const char* password) {
+  std::vector<uint8_t> data = {static_cast<uint8_t>(Mycila::Improv::Command::WIFI_SETTINGS), 0, static_cast<uint8_t>(strlen(ssid))};
+  data.insert(data.end(), ssid, ssid + strlen(ssid));
+  data.push_back(static_cast<uint8_t>(strlen(password)));
+  data.insert(data.end(), password, password + strlen(password));
+  data[1] = static_cast<uint8_t>(data.size() - 2);
+  return data;
+}
+
+static void assertError(const Packet& packet, Mycila::Improv::Error error) {
+  TEST_ASSERT_TRUE(packet.type == Mycila::Improv::Type::ERROR_STATE);
+  TEST_ASSERT_EQUAL(static_cast<uint8_t>(error), packet.data[0]);
+}
+
+static void assertState(const Packet& packet, Mycila::Improv::State state) {
+  TEST_ASSERT_TRUE(packet.type == Mycila::Improv::Type::CURRENT_STATE);
+  TEST_ASSERT_EQUAL(static_cast<uint8_t>(state), packet.data[0]);
+}
+
+// asserts that the strings of a RPC result are the expected ones
+static void assertResult(const Packet& packet, Mycila::Improv::Command command, const std::vector<std::string>& expected) {
+  TEST_ASSERT_TRUE(packet.type == Mycila::Improv::Type::RPC_RESULT);
+  const std::vector<uint8_t>& data = packet.data;
+  TEST_ASSERT_EQUAL(static_cast<uint8_t>(command), data[0]);
+  TEST_ASSERT_EQUAL(data.size() - 2, data[1]);
+  size_t position = 2;
+  for (const std::string& string : expected) {
+    TEST_ASSERT_EQUAL(string.size(), data[position]);
+    TEST_ASSERT_EQUAL_MEMORY(string.data(), data.data() + position + 1, string.size());
+    position += 1 + string.size();
+  }
+  TEST_ASSERT_EQUAL(data.size(), position);
+}
+
+// credentials accepted for a test: no error, then PROVISIONING
+static void assertProvisioning(const std::vector<Packet>& packets) {
+  TEST_ASSERT_EQUAL(2, packets.size());
+  assertError(packets[0], Mycila::Improv::Error::NONE);
+  assertState(packets[1], Mycila::Improv::State::PROVISIONING);
+}
+
+void setUp() {
+  TEST_ASSERT_EQUAL(0, openpty(&client, &device, nullptr, nullptr, nullptr));
+  // like a UART: no echo, no line discipline, binary bytes go through unchanged
+  struct termios tio;
+  tcgetattr(device, &tio);
+  cfmakeraw(&tio);
+  tcsetattr(device, TCSANOW, &tio);
+  tcgetattr(client, &tio);
+  cfmakeraw(&tio);
+  tcsetattr(client, TCSANOW, &tio);
+
+  espConnect = {true, false, {}};
+  improv = new Mycila::Improv::Device([](const uint8_t* data, size_t length) {
+    // no assertion here: a missing reply fails the test on the client side
+    [[maybe_unused]] const ssize_t written = write(device, data, length);
+  });
+  improv->onProvision([](const Mycila::Improv::Credentials& credentials) {
+    if (!espConnect.portalStarted || espConnect.testPending)
+      return false;
+    espConnect.testPending = true;
+    espConnect.received.push_back(std::string(credentials.ssid) + "/" + credentials.password);
+    return true;
+  });
+  improv->onState([](char* url, size_t size) {
+    if (espConnect.testPending)
+      return Mycila::Improv::State::PROVISIONING;
+    if (!espConnect.portalStarted) {
+      snprintf(url, size, "http://192.168.1.42/");
+      return Mycila::Improv::State::PROVISIONED;
+    }
+    return Mycila::Improv::State::READY;
+  });
+  improv->onInfo([](const char* info[4]) {
+    info[0] = "ESPConnect";
+    info[1] = "1.0.0";
+    info[2] = "ESP32";
+    info[3] = "arduino-1";
+  });
+  improv->onNetworks([]() {
+    improv->sendNetwork("MyNetwork", -52, true);
+    improv->sendNetwork("Guest", -80, false);
+  });
+}
+
+void tearDown() {
+  delete improv;
+  close(client);
+  close(device);
+}
+
+void test_wifi_settings_rpc_provisioned() {
+  sendRPC(wifiSettings("MyNetwork", "secret123"));
+  assertProvisioning(receive(2));
+  TEST_ASSERT_EQUAL(1, espConnect.received.size());
+  TEST_ASSERT_EQUAL_STRING("MyNetwork/secret123", espConnect.received[0].c_str());
+
+  // credential test passed, like from ESPConnect::_processCredentialTest()
+  espConnect.testPending = false;
+  espConnect.portalStarted = false;
+  improv->provisioned("http://192.168.1.42/");
+  std::vector<Packet> packets = receive(2);
+  TEST_ASSERT_EQUAL(2, packets.size());
+  assertState(packets[0], Mycila::Improv::State::PROVISIONED);
+  assertResult(packets[1], Mycila::Improv::Command::WIFI_SETTINGS, {"http://192.168.1.42/"});
+
+  // the state is asked again by the client
+  sendRPC({static_cast<uint8_t>(Mycila::Improv::Command::GET_CURRENT_STATE), 0});
+  packets = receive(2);
+  TEST_ASSERT_EQUAL(2, packets.size());
+  assertState(packets[0], Mycila::Improv::State::PROVISIONED);
+  assertResult(packets[1], Mycila::Improv::Command::GET_CURRENT_STATE, {"http://192.168.1.42/"});
+}
+
+void test_wifi_settings_rpc_failed() {
+  sendRPC(wifiSettings("MyNetwork", "wrongpassword"));
+  assertProvisioning(receive(2));
+
+  // while the test is pending
+  sendRPC({static_cast<uint8_t>(Mycila::Improv::Command::GET_CURRENT_STATE), 0});
+  std::vector<Packet> packets = receive(1);
+  TEST_ASSERT_EQUAL(1, packets.size());
+  assertState(packets[0], Mycila::Improv::State::PROVISIONING);
+
+  // a second request is refused until the test ends
+  sendRPC(wifiSettings("Other", "secret123"));
+  packets = receive(1);
+  TEST_ASSERT_EQUAL(1, packets.size());
+  assertError(packets[0], Mycila::Improv::Error::UNABLE_TO_CONNECT);
+
+  // credential test failed: the client can try again
+  espConnect.testPending = false;
+  improv->failed();
+  packets = receive(2);
+  TEST_ASSERT_EQUAL(2, packets.size());
+  assertError(packets[0], Mycila::Improv::Error::UNABLE_TO_CONNECT);
+  assertState(packets[1], Mycila::Improv::State::READY);
+
+  sendRPC(wifiSettings("MyNetwork", "secret123"));
+  assertProvisioning(receive(2));
+  TEST_ASSERT_EQUAL(2, espConnect.received.size());
+  TEST_ASSERT_EQUAL_STRING("MyNetwork/secret123", espConnect.received[1].c_str());
+}
+
+void test_not_in_portal() {
+  espConnect.portalStarted = false;
+  sendRPC(wifiSettings("MyNetwork", "secret123"));
+  const std::vector<Packet> packets = receive(1);
+  TEST_ASSERT_EQUAL(1, packets.size());
+  assertError(packets[0], Mycila::Improv::Error::UNABLE_TO_CONNECT);
+  TEST_ASSERT_EQUAL(0, espConnect.received.size());
+}
+
+void test_wifi_uri_line() {
+  // escaped ; and : in the SSID, fields in any order
+  const char line[] = "WIFI:T:WPA;P:secret123;S:My\\;Net\\:work;;\r\n";
+  send(line, sizeof(line) - 1);
+  assertProvisioning(receive(2));
+  TEST_ASSERT_EQUAL_STRING("My;Net:work/secret123", espConnect.received[0].c_str());
+}
+
+void test_packet_after_boot_log() {
+  // the device logs on the same serial port: text before a packet, and an incomplete IMPROV header
+  const char noise[] = "[  1234][I] booting...\r\nIMPRO";
+  send(noise, sizeof(noise) - 1);
+  sendRPC(wifiSettings("MyNetwork", ""));
+  assertProvisioning(receive(2));
+  TEST_ASSERT_EQUAL_STRING("MyNetwork/", espConnect.received[0].c_str());
+}
+
+void test_bad_checksum_is_ignored() {
+  uint8_t packet[10 + ESPCONNECT_IMPROV_MAX_DATA];
+  const std::vector<uint8_t> data = wifiSettings("MyNetwork", "secret123");
+  const size_t size = Mycila::Improv::encode(packet, sizeof(packet), Mycila::Improv::Type::RPC, data.data(), data.size());
+  packet[size - 1]++;
+  send(packet, size);
+  TEST_ASSERT_EQUAL(0, receive(1, 200).size());
+  TEST_ASSERT_EQUAL(0, espConnect.received.size());
+}
+
+void test_invalid_rpc() {
+  // the length of the password goes past the end of the data
+  std::vector<uint8_t> data = wifiSettings("MyNetwork", "secret123");
+  data[3 + 9] = 20;
+  sendRPC(data);
+  std::vector<Packet> packets = receive(1);
+  TEST_ASSERT_EQUAL(1, packets.size());
+  assertError(packets[0], Mycila::Improv::Error::INVALID_RPC);
+
+  // password too short for WPA, like in the captive portal
+  sendRPC(wifiSettings("MyNetwork", "short"));
+  packets = receive(1);
+  TEST_ASSERT_EQUAL(1, packets.size());
+  assertError(packets[0], Mycila::Improv::Error::INVALID_RPC);
+
+  // unknown command
+  sendRPC({0x42, 0});
+  packets = receive(1);
+  TEST_ASSERT_EQUAL(1, packets.size());
+  assertError(packets[0], Mycila::Improv::Error::UNKNOWN_RPC);
+  TEST_ASSERT_EQUAL(0, espConnect.received.size());
+}
+
+void test_device_info() {
+  sendRPC({static_cast<uint8_t>(Mycila::Improv::Command::GET_DEVICE_INFO), 0});
+  const std::vector<Packet> packets = receive(1);
+  TEST_ASSERT_EQUAL(1, packets.size());
+  // firmware, version, chip family, hostname
+  assertResult(packets[0], Mycila::Improv::Command::GET_DEVICE_INFO, {"ESPConnect", "1.0.0", "ESP32", "arduino-1"});
+}
+
+void test_wifi_networks() {
+  sendRPC({static_cast<uint8_t>(Mycila::Improv::Command::GET_WIFI_NETWORKS), 0});
+  const std::vector<Packet> packets = receive(3);
+  TEST_ASSERT_EQUAL(3, packets.size());
+  // one result per network, then an empty result
+  assertResult(packets[0], Mycila::Improv::Command::GET_WIFI_NETWORKS, {"MyNetwork", "-52", "YES"});
+  assertResult(packets[1], Mycila::Improv::Command::GET_WIFI_NETWORKS, {"Guest", "-80", "NO"});
+  assertResult(packets[2], Mycila::Improv::Command::GET_WIFI_NETWORKS, {});
+}
+
+void test_aborted() {
+  sendRPC(wifiSettings("MyNetwork", "secret123"));
+  assertProvisioning(receive(2));
+
+  // the captive portal stops during the test
+  improv->aborted();
+  const std::vector<Packet> packets = receive(1);
+  TEST_ASSERT_EQUAL(1, packets.size());
+  assertError(packets[0], Mycila::Improv::Error::UNABLE_TO_CONNECT);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_wifi_settings_rpc_provisioned);
+  RUN_TEST(test_wifi_settings_rpc_failed);
+  RUN_TEST(test_not_in_portal);
+  RUN_TEST(test_wifi_uri_line);
+  RUN_TEST(test_packet_after_boot_log);
+  RUN_TEST(test_bad_checksum_is_ignored);
+  RUN_TEST(test_invalid_rpc);
+  RUN_TEST(test_device_info);
+  RUN_TEST(test_wifi_networks);
+  RUN_TEST(test_aborted);
+  return UNITY_END();
+}